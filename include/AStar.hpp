@@ -2,28 +2,27 @@
 #define ASTAR_HPP
  
 #include "Graph.hpp"
+#include "PathEngine.hpp"
 #include <string>
 #include <vector>
-#include <unordered_map>
  
 using namespace std;
  
 class AStar
 {
 public:
+  // Prints the result of PathEngine::find with the A* estimate
   static vector<string> findPath(Graph &graph, const string &startCity, const string &goalCity);
+
+  // Straight-line estimate from every city id to the goal (0 for dead ids)
+  static vector<int> estimatesTo(const Graph &graph, int goal);
  
 private:
   // Heuristic function (can be enhanced)
-  static int heuristic(Graph& graph,const string &a, const string &b);
- 
-  // Builds the path from cameFrom map
-  static vector<string> reconstructPath(const unordered_map<string, string> &cameFrom,
-                                        const string &startCity,
-                                        const string &goalCity);
+  static int heuristic(const string &a, const string &b);
  
   // Prints the full path and total cost
-  static void displayPath(const vector<string> &path, int totalCost);
+  static void displayPath(const Graph &graph, const PathResult &result);
 };
  
 #endif
\ No newline at end of file
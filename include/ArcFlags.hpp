@@ -0,0 +1,44 @@
+#ifndef ARC_FLAGS_HPP
+#define ARC_FLAGS_HPP
+
+#include "CompactGraph.hpp"
+#include "ThreadPool.hpp"
+#include <vector>
+#include <string>
+#include <cstdint>
+
+using namespace std;
+
+class Graph;
+
+// Goal-directed pruning for Dijkstra. The graph is split into at most 64
+// regions, and each edge carries a bitmask of the regions it leads to on
+// some shortest path. A search towards region r only relaxes edges with bit r set.
+class ArcFlags {
+public:
+    static constexpr int MAX_REGIONS = 64;
+
+    // regionCount <= 0 picks roughly sqrt(cities) regions
+    static ArcFlags build(const CompactGraph& graph, int regionCount, ThreadPool& pool);
+
+    // Pruned Dijkstra; fills nodes (city ids) and returns the distance, or -1 if unreachable.
+    // settled, when given, receives the number of cities taken off the queue.
+    int shortestPath(const CompactGraph& graph, int source, int target, vector<int>& nodes,
+                     size_t* settled = nullptr) const;
+
+    // Flags are stored by city name next to the graph file, e.g. data/x.txt.flags
+    void save(const string& filename, const Graph& graph, const CompactGraph& compact) const;
+    static bool load(const string& filename, const Graph& graph, const CompactGraph& compact, ArcFlags& flags);
+
+    int regionCount() const { return regions; }
+    int regionOf(int node) const { return region[node]; }
+
+private:
+    static void partition(const CompactGraph& graph, int regionCount, vector<int>& region);
+
+    int regions = 1;
+    vector<int> region;        // Region of every node id, -1 for dead slots
+    vector<uint64_t> flags;    // One mask per edge id
+};
+
+#endif
@@ -0,0 +1,67 @@
+#ifndef BATCH_RUNNER_HPP
+#define BATCH_RUNNER_HPP
+
+#include "Graph.hpp"
+#include <string>
+#include <vector>
+#include <ostream>
+
+using namespace std;
+
+// Non-interactive query mode:
+//   MiniWasilni --graph data/x.txt --queries q.csv [--algo dijkstra|astar|arcflags|crp|reach]
+//               [--threads N] [--output results.csv]
+// Each query line is "SOURCE,TARGET" (blank lines and lines starting with '#' are skipped).
+// Each result line is "SOURCE,TARGET,DISTANCE,PATH" with DISTANCE -1 when unreachable;
+// --algo reach only answers whether a path exists, as "SOURCE,TARGET,1" or "SOURCE,TARGET,0".
+//
+// Delta-stepping scaling benchmark (1/2/4/8/16 threads, checked against Dijkstra):
+//   MiniWasilni --graph data/x.txt --bench-sssp SOURCE [--delta D]
+//
+// Customizable route planning benchmark (partition, customization per thread count,
+// N random queries against Dijkstra, then re-customization after a traffic update):
+//   MiniWasilni --graph data/x.txt --bench-crp N
+//
+// Traversal benchmark (id/bitset DFS and BFS against the name/hash-set versions,
+// then parallel BFS at 1/2/4/8/16 threads):
+//   MiniWasilni --graph data/x.txt --bench-traversal SOURCE
+//
+// Max-flow benchmark on synthetic SIZE x SIZE grid- and road-like networks, with a
+// super source on the west edge and a super sink on the east edge (checked against Dinic):
+//   MiniWasilni --bench-flow SIZE
+//
+// Regression checks on small built-in graphs; the exit code is 1 if any result is wrong:
+//   MiniWasilni --check centrality   (betweenness with zero-length roads tying distances)
+class BatchRunner {
+public:
+    // Returns the process exit code
+    static int run(int argc, char* argv[]);
+
+private:
+    struct Options {
+        string graphFile;
+        string queryFile;
+        string outputFile;
+        string algorithm = "dijkstra";
+        unsigned threads = 0;  // 0 = hardware concurrency
+        string benchSource;
+        int delta = 0;         // 0 = DeltaStepping::defaultDelta
+        int crpQueries = 0;    // > 0 selects the CRP benchmark
+        string traversalSource;
+        int flowSize = 0;      // > 0 selects the max-flow benchmark
+        string check;          // Non-empty selects a regression check
+    };
+
+    static bool parseArguments(int argc, char* argv[], Options& options);
+    static void printUsage(const char* program);
+    static bool loadGraph(const string& filename, Graph& graph);
+    static string answerQuery(const Graph& graph, const string& line, const string& algorithm);
+    static int runQueries(const Graph& graph, const Options& options);
+    static int runSsspBenchmark(const Graph& graph, const Options& options);
+    static int runCrpBenchmark(Graph& graph, const Options& options);
+    static int runTraversalBenchmark(const Graph& graph, const Options& options);
+    static int runFlowBenchmark(const Options& options);
+    static int runCentralityCheck();
+};
+
+#endif
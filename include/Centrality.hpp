@@ -0,0 +1,38 @@
+#ifndef CENTRALITY_HPP
+#define CENTRALITY_HPP
+
+#include "Graph.hpp"
+#include "CompactGraph.hpp"
+#include "ThreadPool.hpp"
+#include <vector>
+
+using namespace std;
+
+// Per city id; dead slots score 0
+struct CentralityScores {
+    vector<double> betweenness;   // Shortest paths between other cities that pass through the city
+    vector<double> closeness;     // Wasserman-Faust closeness of the distances *to* the city
+    int sources = 0;              // Searches run; fewer than the city count means estimates
+    bool weighted = false;        // Road distances, or hop counts
+};
+
+// Brandes' algorithm: one shortest-path search per source city, then the
+// dependencies are accumulated back up the search in reverse order. Sources
+// are spread over the pool and every worker sums into its own arrays, which
+// are added together at the end.
+class Centrality {
+public:
+    // The GUI searches from every city up to EXACT_LIMIT cities, and samples above it
+    static constexpr int EXACT_LIMIT = 2000;
+    static constexpr int DEFAULT_SAMPLES = 256;
+
+    static void showRanking(Graph& graph);  // Interactive CLI entry point
+
+    // samples <= 0, or at least the number of cities, searches from every city.
+    // Otherwise that many sources are drawn at random and the sums are scaled
+    // by cities / samples, an unbiased estimate (Brandes & Pich).
+    static CentralityScores compute(const CompactGraph& graph, bool weighted, ThreadPool& pool,
+                                    int samples = 0, unsigned seed = 1);
+};
+
+#endif
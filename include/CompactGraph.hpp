@@ -0,0 +1,40 @@
+#ifndef COMPACT_GRAPH_HPP
+#define COMPACT_GRAPH_HPP
+
+#include <vector>
+
+using namespace std;
+
+class Graph;
+
+// Read-only CSR snapshot of a Graph for the heavy algorithms.
+// Node ids are the graph's stable city ids, so deleted cities leave dead slots.
+// Edge ids are positions in the outgoing arrays and keep the adjacency order.
+class CompactGraph {
+public:
+    static CompactGraph build(const Graph& graph);
+
+    int nodeCount() const { return static_cast<int>(alive.size()); }
+    int edgeCount() const { return static_cast<int>(targets.size()); }
+    bool isAlive(int node) const { return alive[node] != 0; }
+    int outDegree(int node) const { return offsets[node + 1] - offsets[node]; }
+    int inDegree(int node) const { return inOffsets[node + 1] - inOffsets[node]; }
+
+    // Outgoing edges of u are [offsets[u], offsets[u + 1])
+    vector<int> offsets;
+    vector<int> targets;
+    vector<int> weights;
+
+    // Incoming edges of v are [inOffsets[v], inOffsets[v + 1]);
+    // inEdges holds the matching outgoing edge id
+    vector<int> inOffsets;
+    vector<int> sources;
+    vector<int> inEdges;
+
+    vector<char> alive;
+    int liveCount = 0;
+    int maxWeight = 0;
+    long long totalWeight = 0;
+};
+
+#endif
@@ -0,0 +1,45 @@
+#ifndef CUSTOMIZED_ROUTES_HPP
+#define CUSTOMIZED_ROUTES_HPP
+
+#include "CompactGraph.hpp"
+#include "MultiLevelPartition.hpp"
+#include "ThreadPool.hpp"
+#include <vector>
+#include <memory>
+
+using namespace std;
+
+// Metric half of customizable route planning (Delling et al.). For every cell
+// of a MultiLevelPartition it stores the shortest distance inside the cell
+// from each entry to each exit. Customization reuses the partition and the
+// level below, so it can be redone in parallel whenever distances change.
+// Queries run a bidirectional Dijkstra that crosses cells far from the source
+// and target through these cliques instead of their contents.
+class CustomizedRoutes {
+public:
+    static CustomizedRoutes customize(shared_ptr<const MultiLevelPartition> partition,
+                                      const CompactGraph& graph, ThreadPool& pool);
+
+    // Fills nodes (city ids, cliques expanded) and returns the distance, or -1 if unreachable.
+    // settled, when given, receives the number of cities taken off both queues.
+    int shortestPath(const CompactGraph& graph, int source, int target, vector<int>& nodes,
+                     size_t* settled = nullptr) const;
+
+    const MultiLevelPartition& partition() const { return *cells; }
+
+private:
+    // Entry -> exit distance within a cell, INT_MAX if the cell does not connect them
+    int clique(int level, int cell, int entry, int exit) const {
+        const MultiLevelPartition& p = *cells;
+        return weights[level][p.cliqueOffset(level, cell) + entry * p.exits(level, cell).size() + exit];
+    }
+
+    void customizeCell(const CompactGraph& graph, int level, int cell);
+    // Append the in-cell shortest path from -> to (excluding from) to nodes
+    void unpack(const CompactGraph& graph, int level, int cell, int from, int to, vector<int>& nodes) const;
+
+    shared_ptr<const MultiLevelPartition> cells;
+    vector<vector<int>> weights;   // Per level, every cell's clique block
+};
+
+#endif
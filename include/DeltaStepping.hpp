@@ -0,0 +1,25 @@
+#ifndef DELTA_STEPPING_HPP
+#define DELTA_STEPPING_HPP
+
+#include "CompactGraph.hpp"
+#include "ThreadPool.hpp"
+#include <vector>
+#include <climits>
+
+using namespace std;
+
+// Parallel single-source shortest paths (Meyer & Sanders delta-stepping).
+// Edges no heavier than delta are relaxed repeatedly inside a bucket,
+// heavier ones once per bucket. Produces the same distances as Dijkstra.
+class DeltaStepping {
+public:
+    static constexpr int UNREACHABLE = INT_MAX;
+
+    // delta <= 0 picks the average edge weight
+    static vector<int> distances(const CompactGraph& graph, int source,
+                                 ThreadPool& pool, int delta = 0);
+
+    static int defaultDelta(const CompactGraph& graph);
+};
+
+#endif
@@ -3,6 +3,7 @@
 #define DIJKSTRA_HPP
 
 #include "Graph.hpp"
+#include "PathEngine.hpp"
 #include <string>
 #include <vector>
 #include <unordered_map>
@@ -14,13 +15,15 @@ using namespace std;
 class Dijkstra {
 public:
     static void findPath(Graph& graph);  // Main interface for path finding
-    static void dijkstra(Graph& graph, const string& startCity, const string& endCity);
+    // Prints the result of PathEngine::find; the arc-flags and overlay
+    // variants build their preprocessing on first use
+    static void dijkstra(Graph& graph, const string& startCity, const string& endCity,
+                         PathAlgorithm algorithm = PathAlgorithm::Dijkstra);
+    // Distances from source to every node of a CSR snapshot (INT_MAX if unreachable)
+    static vector<int> distancesFrom(const CompactGraph& graph, int source);
     static void aStar(Graph& graph, const string& startCity, const string& endCity);  // Placeholder for future implementation
 private:
-    static vector<string> reconstructPath(const unordered_map<string, string>& previous, 
-                                        const string& startCity, 
-                                        const string& endCity);
-    static void displayPath(const vector<string>& path, int totalDistance);
+    static void displayPath(const Graph& graph, const PathResult& result);
 };
 
 #endif
\ No newline at end of file
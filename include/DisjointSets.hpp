@@ -0,0 +1,67 @@
+#ifndef DISJOINT_SETS_HPP
+#define DISJOINT_SETS_HPP
+
+#include <vector>
+#include <utility>
+
+using namespace std;
+
+// Union-find over dense ids with path compression and union by rank;
+// find and unite cost O(alpha(n)) amortized.
+class DisjointSets {
+public:
+    void clear() {
+        parent.clear();
+        rank.clear();
+        sets = 0;
+    }
+
+    // Adds a singleton set and returns its id
+    int add() {
+        parent.push_back(static_cast<int>(parent.size()));
+        rank.push_back(0);
+        sets++;
+        return parent.back();
+    }
+
+    int find(int x) {
+        int root = x;
+        while (parent[root] != root) {
+            root = parent[root];
+        }
+        while (parent[x] != root) {
+            int next = parent[x];
+            parent[x] = root;
+            x = next;
+        }
+        return root;
+    }
+
+    // False if a and b were already in the same set
+    bool unite(int a, int b) {
+        a = find(a);
+        b = find(b);
+        if (a == b) {
+            return false;
+        }
+        if (rank[a] < rank[b]) {
+            swap(a, b);
+        }
+        parent[b] = a;
+        if (rank[a] == rank[b]) {
+            rank[a]++;
+        }
+        sets--;
+        return true;
+    }
+
+    int size() const { return static_cast<int>(parent.size()); }
+    int setCount() const { return sets; }
+
+private:
+    vector<int> parent;
+    vector<unsigned char> rank;
+    int sets = 0;
+};
+
+#endif
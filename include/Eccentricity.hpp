@@ -0,0 +1,62 @@
+#ifndef ECCENTRICITY_HPP
+#define ECCENTRICITY_HPP
+
+#include "Graph.hpp"
+#include "CompactGraph.hpp"
+#include "StrongComponents.hpp"
+#include "SearchWorkspace.hpp"
+#include <vector>
+
+using namespace std;
+
+// Eccentricities of the largest strongly connected component; distances
+// between other cities can be infinite, so they are left out
+struct EccentricityResult {
+    vector<int> eccentricity;   // Per city id; -1 outside the component, or not pinned down
+    int component = -1;         // Strong component measured
+    int cities = 0;
+    int diameter = 0;
+    int diameterFrom = -1;      // Cities realising the diameter
+    int diameterTo = -1;
+    int radius = 0;
+    int center = -1;
+    int searches = 0;           // Forward plus backward searches run
+
+    // With a search limit the bounds may not close: diameter is then the
+    // widest distance actually found and radius the best upper bound
+    bool exact = true;
+    int diameterUpper = 0;
+    int radiusLower = 0;
+    bool weighted = false;      // Road distances, or hop counts
+};
+
+// Exact eccentricities by bounding (Takes & Kosters, with the directed bounds
+// of iFUB-style diameter algorithms). A forward and a backward search from v
+// give every w in the component
+//     max(d(w, v), ecc(v) - d(v, w)) <= ecc(w) <= d(w, v) + ecc(v),
+// and cities whose bounds meet need no search of their own. Sources alternate
+// between the largest upper bound and the smallest lower bound. When only the
+// diameter and radius are wanted, cities whose bounds rule out both are dropped
+// as well, which is what keeps the search count low on grid-like graphs.
+class Eccentricity {
+public:
+    // The CLI gives up and reports bounds after this many searches
+    static constexpr int CLI_SEARCH_LIMIT = 64;
+
+    static void showDiameter(Graph& graph);  // Interactive CLI entry point
+
+    // everyCity = false fills in only the eccentricities the bounds happened to settle.
+    // searchLimit <= 0 searches until every bound has closed.
+    static EccentricityResult compute(const CompactGraph& graph, const StrongComponents& components,
+                                      bool weighted, bool everyCity = true, int searchLimit = 0);
+
+    // One search; -1 outside the largest strongly connected component
+    static int of(const CompactGraph& graph, const StrongComponents& components, int city, bool weighted);
+
+private:
+    // Search within the component; returns ecc(source) and the farthest city
+    static int sweep(const CompactGraph& graph, const StrongComponents& components, int source,
+                     bool forward, bool weighted, SearchWorkspace& workspace, int& farthest);
+};
+
+#endif
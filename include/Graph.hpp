@@ -13,6 +13,17 @@
 #include <queue>
 #include <stack>        
 #include <algorithm>
+#include <functional>
+
+#include "PathCache.hpp"
+#include "CompactGraph.hpp"
+#include "VersionedSlot.hpp"
+#include "ArcFlags.hpp"
+#include "CustomizedRoutes.hpp"
+#include "StrongComponents.hpp"
+#include "ReachabilityIndex.hpp"
+#include "GraphObserver.hpp"
+#include "DisjointSets.hpp"
 
 using namespace std;
 
@@ -20,6 +31,7 @@ class Graph {
     friend class IOManager;
     friend class Traversal;
     friend class Dijkstra;
+    friend class CompactGraph;
 public:
     void addCity(const string& city);
     void deleteCity(const string& from, const string& to);
@@ -30,17 +42,87 @@ public:
     void saveGraph(const string &filename);
     void loadGraph(const string& filename);
     void sortConnections(bool byDistance = false);
+    void updateEdge(const string& from, const string& to, int distance);
+
+    // Remove every city and edge, keeping observers attached. Restarts city ids.
+    void clear();
 
     const unordered_map<string, vector<pair<string, int>>>& getAdjList() const { return adjList; }
+
+    // Incoming connections of every city, kept in step with getAdjList()
+    const unordered_map<string, vector<pair<string, int>>>& getInAdjList() const { return inAdjList; }
+
+    // Observers are told about every edit after it has been applied
+    void addObserver(GraphObserver* observer) { observers.add(observer); }
+    void removeObserver(GraphObserver* observer) { observers.remove(observer); }
     
     // Check if a city exists
     bool cityExists(const string& city) const;
     
     // Convert city name to standard format (uppercase)
     static string standardizeCity(const string& city);
+
+    // Stable numeric id of a city, -1 if it does not exist. Ids are never reused
+    // until clear(), which numbers the next cities from 0 again; anything holding
+    // ids must drop them when it is told onGraphCleared.
+    int cityId(const string& city) const;
+    const string& cityName(int id) const;
+
+    // Bumped on every successful mutation
+    unsigned long version() const { return graphVersion; }
+    // Bumped only when cities or edges come or go, not when distances change
+    unsigned long topologyVersion() const { return topologyCounter; }
+
+    // Shortest-path results computed against this graph
+    PathCache& pathCache() const { return cache; }
+
+    // CSR snapshot of the current version, rebuilt lazily after mutations
+    shared_ptr<const CompactGraph> compact() const;
+
+    // Arc-flags for the current version, precomputed on first use
+    shared_ptr<const ArcFlags> arcFlags() const;
+    bool hasArcFlags() const { return arcFlagsSlot.peek(graphVersion) != nullptr; }
+
+    // Customizable route planning: the partition is kept while the topology is
+    // unchanged, so a distance update only re-runs the (parallel) customization
+    shared_ptr<const CustomizedRoutes> customizedRoutes() const;
+    bool hasCustomizedRoutes() const { return routesSlot.peek(graphVersion) != nullptr; }
+
+    // Whether two cities are linked by edges in either direction (same island).
+    // O(alpha(n)): kept up to date by addEdge, rebuilt once after a deletion.
+    // Compresses paths, so it is not safe to call from several threads at once.
+    bool sameComponent(const string& a, const string& b) const;
+    // Number of islands (weakly connected components)
+    int componentCount() const;
+
+    // Strongly connected components and condensation DAG, kept while the topology is unchanged
+    shared_ptr<const StrongComponents> strongComponents() const;
+    // Reachability labels over the condensation DAG, kept while the topology is unchanged
+    shared_ptr<const ReachabilityIndex> reachability() const;
 private:
+    // Union-find over city ids after deletions have made it stale
+    void rebuildIslands() const;
+
+    // Advance the version, carrying over the cached paths isStale accepts
+    void bumpVersion(const function<bool(const CachedPath&)>& isStale, bool topologyChanged = true);
+
 //    Private to avoid editing by non allowed
     unordered_map<string, vector<pair<string, int>>> adjList;
+    unordered_map<string, vector<pair<string, int>>> inAdjList;
+    unordered_map<string, int> cityIds;
+    vector<string> cityNames;
+    unsigned long graphVersion = 0;
+    unsigned long topologyCounter = 0;
+    mutable PathCache cache;
+    mutable VersionedSlot<CompactGraph> compactSlot;
+    mutable VersionedSlot<ArcFlags> arcFlagsSlot;
+    mutable VersionedSlot<MultiLevelPartition> partitionSlot;   // Keyed by topologyVersion()
+    mutable VersionedSlot<CustomizedRoutes> routesSlot;
+    mutable VersionedSlot<StrongComponents> componentsSlot;    // Keyed by topologyVersion()
+    mutable VersionedSlot<ReachabilityIndex> reachabilitySlot; // Keyed by topologyVersion()
+    mutable DisjointSets islands;          // Indexed by city id; deleted cities stay singletons
+    mutable bool islandsStale = false;     // Set by deletions, which union-find cannot undo
+    ObserverList observers;
 };
 
 #endif
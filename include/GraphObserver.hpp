@@ -0,0 +1,49 @@
+#ifndef GRAPH_OBSERVER_HPP
+#define GRAPH_OBSERVER_HPP
+
+#include <string>
+#include <vector>
+#include <algorithm>
+
+using namespace std;
+
+// Receives edits after the Graph has applied them. City names are standardized;
+// cityId() translates them, except for a removed city, whose former id is passed along.
+class GraphObserver {
+public:
+    virtual ~GraphObserver() = default;
+    virtual void onEdgeAdded(const string& from, const string& to, int distance) = 0;
+    virtual void onEdgeRemoved(const string& from, const string& to, int distance) = 0;
+    virtual void onEdgeWeightChanged(const string& from, const string& to, int oldDistance, int newDistance) = 0;
+    virtual void onCityRemoved(const string& city, int id) = 0;
+    // City ids are handed out from 0 again after this; drop any ids held
+    virtual void onGraphCleared() = 0;
+};
+
+// Observers watch one Graph object rather than its contents,
+// so copying a graph neither copies nor drops them.
+class ObserverList {
+public:
+    ObserverList() = default;
+    ObserverList(const ObserverList&) {}
+    ObserverList& operator=(const ObserverList&) { return *this; }
+
+    void add(GraphObserver* observer) { observers.push_back(observer); }
+    void remove(GraphObserver* observer) {
+        observers.erase(std::remove(observers.begin(), observers.end(), observer), observers.end());
+    }
+
+    // Observers may detach themselves while being notified
+    template <typename Callback>
+    void notify(Callback callback) const {
+        vector<GraphObserver*> snapshot = observers;
+        for (GraphObserver* observer : snapshot) {
+            callback(*observer);
+        }
+    }
+
+private:
+    vector<GraphObserver*> observers;
+};
+
+#endif
@@ -0,0 +1,45 @@
+#ifndef HYPER_ANF_HPP
+#define HYPER_ANF_HPP
+
+#include "Graph.hpp"
+#include "CompactGraph.hpp"
+#include "ThreadPool.hpp"
+#include <vector>
+
+using namespace std;
+
+// Approximate neighbourhood function of the whole graph
+struct NeighbourhoodFunction {
+    vector<double> reachable;     // Per city id: estimated cities it reaches, itself included; 0 for dead slots
+    vector<double> pairs;         // pairs[t]: estimated (x, y) with y within t hops of x, self pairs included
+    int iterations = 0;           // Hops until no counter changed (or the limit)
+    bool converged = false;
+    int registers = 0;            // Per counter; relative error about 1.04 / sqrt(registers) per city
+
+    // Over the pairs joined by a path, self pairs left out; 0 when there are none
+    double averageDistance = 0;
+    double effectiveDiameter = 0; // Hops, interpolated, within which 90% of those pairs lie
+};
+
+// HyperANF (Boldi, Rosa & Vigna): every city keeps a HyperLogLog counter of
+// the cities it reaches within t hops, and step t + 1 takes the register-wise
+// maximum with the counters of its out-neighbours. Registers are bytes, eight
+// to a 64-bit word, and the maximum is taken a word at a time with a broadword
+// compare. Cities are spread over the pool. A city is only recomputed when one
+// of its out-neighbours changed in the previous step.
+class HyperAnf {
+public:
+    static constexpr int DEFAULT_LOG2_REGISTERS = 6;
+    static constexpr int MIN_LOG2_REGISTERS = 4;
+    static constexpr int MAX_LOG2_REGISTERS = 12;
+
+    static void showStatistics(Graph& graph);  // Interactive CLI entry point
+
+    // log2Registers is clamped to [MIN_LOG2_REGISTERS, MAX_LOG2_REGISTERS].
+    // maxIterations <= 0 runs until the counters stop changing.
+    static NeighbourhoodFunction estimate(const CompactGraph& graph, ThreadPool& pool,
+                                          int log2Registers = DEFAULT_LOG2_REGISTERS,
+                                          int maxIterations = 0, unsigned long long seed = 1);
+};
+
+#endif
@@ -0,0 +1,36 @@
+#ifndef ISOCHRONE_HPP
+#define ISOCHRONE_HPP
+
+#include "Graph.hpp"
+#include "SearchWorkspace.hpp"
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// A city inside the largest budget of an isochrone query
+struct ReachableCity {
+    int city;       // City id
+    int distance;
+    int band;       // Index of the smallest budget that covers the city
+};
+
+// Budget-bounded Dijkstra: "which cities are within 30 of this hub?"
+// The search stops at the largest budget, so its cost follows the
+// reachable region rather than the graph size.
+class Isochrone {
+public:
+    static void findReachable(Graph& graph);  // Interactive CLI entry point
+
+    // Budgets are sorted and deduplicated; one search answers all of them.
+    // Results come back in order of distance.
+    static vector<ReachableCity> reachable(const CompactGraph& graph, int source,
+                                           vector<int> budgets, SearchWorkspace& workspace);
+    static vector<ReachableCity> reachable(const Graph& graph, const string& sourceCity,
+                                           const vector<int>& budgets);
+
+    // The budgets reachable() actually used
+    static vector<int> normalizeBudgets(vector<int> budgets);
+};
+
+#endif
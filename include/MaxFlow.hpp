@@ -0,0 +1,43 @@
+#ifndef MAX_FLOW_HPP
+#define MAX_FLOW_HPP
+
+#include "CompactGraph.hpp"
+#include <vector>
+
+using namespace std;
+
+class Graph;
+
+// One road of a minimum cut; its capacity is the road's distance value
+struct CutEdge {
+    int from;
+    int to;
+    int capacity;
+};
+
+struct FlowResult {
+    long long value = 0;          // Maximum flow, equal to the cut capacity
+    vector<CutEdge> cut;          // Saturated roads from the source side to the sink side
+    vector<char> sourceSide;      // 1 for cities that cannot reach the sink in the residual graph
+    size_t pushes = 0;
+    size_t relabels = 0;
+    size_t globalRelabels = 0;
+    size_t gaps = 0;
+};
+
+// Maximum flow and minimum cut with edge distances read as capacities.
+// Highest-label push-relabel (Goldberg & Tarjan; Cherkassky & Goldberg's
+// heuristics): labels are periodically reset to exact distances to the sink
+// by a backward BFS (global relabeling), and when no city is left at some
+// label, every city above it is cut off at once (gap relabeling).
+// Only the first phase runs: it yields the flow value and the cut, not a
+// decomposition of the flow into paths.
+class MaxFlow {
+public:
+    static FlowResult compute(const CompactGraph& graph, int source, int sink);
+
+    // CLI entry point: capacity between two cities and the roads limiting it
+    static void showCapacity(Graph& graph);
+};
+
+#endif
@@ -0,0 +1,33 @@
+#ifndef MINIMUM_SPANNING_HPP
+#define MINIMUM_SPANNING_HPP
+
+#include "CompactGraph.hpp"
+#include "ThreadPool.hpp"
+#include "Traversal.hpp"
+#include <vector>
+
+using namespace std;
+
+// Minimum-cost set of edges spanning a set of cities
+struct SpanningStructure {
+    vector<int> nodes;          // Cities spanned, city ids
+    vector<TreeEdge> edges;     // Each edge keeps its real direction and distance
+    long long totalDistance = 0;
+    int treeCount = 0;          // Trees in a forest; 1 for an arborescence
+};
+
+class MinimumSpanning {
+public:
+    // Minimum spanning forest of the undirected view (parallel Boruvka). In every
+    // round each city offers the cheapest edge leaving its component, in either
+    // direction, and components take the minimum with an atomic compare-and-swap.
+    // Ties go to the lower edge id, so the forest does not depend on scheduling.
+    static SpanningStructure forest(const CompactGraph& graph, ThreadPool& pool);
+
+    // Minimum-cost arborescence rooted at root over the cities it can reach:
+    // Edmonds' algorithm in Tarjan's O(E log V) form, with one skew heap of
+    // incoming edges per contracted city and lazy weight offsets.
+    static SpanningStructure arborescence(const CompactGraph& graph, int root);
+};
+
+#endif
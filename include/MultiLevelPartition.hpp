@@ -0,0 +1,55 @@
+#ifndef MULTI_LEVEL_PARTITION_HPP
+#define MULTI_LEVEL_PARTITION_HPP
+
+#include "CompactGraph.hpp"
+#include <vector>
+#include <cstddef>
+
+using namespace std;
+
+// Metric-independent half of customizable route planning: nested cells over
+// the cities plus, for every cell, the cities where edges enter and leave it.
+// Only depends on which edges exist, so it survives any change of distances.
+// Level 0 has the smallest cells; every cell lies inside one cell of the next level.
+class MultiLevelPartition {
+public:
+    // cellSizes holds the maximum cities per cell, smallest first; empty picks defaults.
+    // Levels that would have fewer than about 8 cells are dropped.
+    static MultiLevelPartition build(const CompactGraph& graph, vector<int> cellSizes = {});
+
+    int levelCount() const { return static_cast<int>(levels.size()); }
+    int cellCount(int level) const { return static_cast<int>(levels[level].entries.size()); }
+    int maxCellSize(int level) const { return levels[level].maxCellSize; }
+
+    // -1 for dead city ids
+    int cellOf(int level, int node) const { return levels[level].cell[node]; }
+
+    // Cities of a cell with an edge coming from / going to another cell of the same level
+    const vector<int>& entries(int level, int cell) const { return levels[level].entries[cell]; }
+    const vector<int>& exits(int level, int cell) const { return levels[level].exits[cell]; }
+    // Position in entries()/exits() of the city's own cell, -1 if it is not one
+    int entryIndex(int level, int node) const { return levels[level].entryIndex[node]; }
+    int exitIndex(int level, int node) const { return levels[level].exitIndex[node]; }
+
+    // Each cell owns an entries x exits block of clique distances
+    size_t cliqueOffset(int level, int cell) const { return levels[level].cliqueOffset[cell]; }
+    size_t cliqueSize(int level) const { return levels[level].cliqueOffset.back(); }
+
+private:
+    struct Level {
+        int maxCellSize = 0;
+        vector<int> cell;
+        vector<vector<int>> entries;
+        vector<vector<int>> exits;
+        vector<int> entryIndex;
+        vector<int> exitIndex;
+        vector<size_t> cliqueOffset;   // One per cell plus the total
+    };
+
+    void assignCells(const CompactGraph& graph);
+    void findBoundaries(const CompactGraph& graph);
+
+    vector<Level> levels;
+};
+
+#endif
@@ -0,0 +1,30 @@
+#ifndef MULTI_SOURCE_BFS_HPP
+#define MULTI_SOURCE_BFS_HPP
+
+#include "CompactGraph.hpp"
+#include "ThreadPool.hpp"
+#include <vector>
+
+using namespace std;
+
+// Many BFS traversals in one pass (MS-BFS, Then et al.). Every city carries
+// one bit per source for its seen, frontier and next-frontier sets, so a
+// single scan of a city's edges advances every BFS that has reached it.
+// Batches of up to BATCH sources run on the pool side by side.
+class MultiSourceBfs {
+public:
+    static constexpr int WORD_BITS = 64;
+    static constexpr int BATCH = 256;   // Four words per city
+
+    // Row i holds hop counts from sources[i] by city id, -1 where unreachable.
+    // Needs sources x cities ints; hopHistogram is the compact alternative.
+    static vector<vector<int>> hopMatrix(const CompactGraph& graph, const vector<int>& sources,
+                                         ThreadPool& pool);
+
+    // Row i counts the cities exactly h hops from sources[i] (h = 0 is the source).
+    // Enough for hop closeness, k-hop neighbourhood sizes and reach counts.
+    static vector<vector<int>> hopHistogram(const CompactGraph& graph, const vector<int>& sources,
+                                            ThreadPool& pool);
+};
+
+#endif
@@ -0,0 +1,36 @@
+#ifndef NODE_BITSET_HPP
+#define NODE_BITSET_HPP
+
+#include <vector>
+#include <cstdint>
+
+using namespace std;
+
+// One bit per city id, packed 64 to a word. Used as the visited set of the
+// traversals, where an unordered_set<string> would hash a name per step.
+class NodeBitset {
+public:
+    NodeBitset() = default;
+    explicit NodeBitset(int nodeCount) { reset(nodeCount); }
+
+    void reset(int nodeCount) { words.assign((static_cast<size_t>(nodeCount) + 63) / 64, 0); }
+
+    bool test(int node) const { return (words[node >> 6] >> (node & 63)) & 1; }
+    void set(int node) { words[node >> 6] |= uint64_t(1) << (node & 63); }
+
+    // Sets the bit and reports whether it was clear before
+    bool insert(int node) {
+        uint64_t& word = words[node >> 6];
+        uint64_t mask = uint64_t(1) << (node & 63);
+        if (word & mask) {
+            return false;
+        }
+        word |= mask;
+        return true;
+    }
+
+private:
+    vector<uint64_t> words;
+};
+
+#endif
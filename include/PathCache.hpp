@@ -0,0 +1,80 @@
+#ifndef PATH_CACHE_HPP
+#define PATH_CACHE_HPP
+
+#include <string>
+#include <vector>
+#include <list>
+#include <unordered_map>
+#include <functional>
+#include <mutex>
+
+using namespace std;
+
+// Which search produced a cached result
+enum class PathAlgorithm {
+    Dijkstra,
+    AStar,
+    ArcFlags,
+    Crp
+};
+
+// One cached shortest-path answer. Paths are kept as city ids, not names.
+struct CachedPath {
+    int source = -1;
+    int target = -1;
+    PathAlgorithm algorithm = PathAlgorithm::Dijkstra;
+    unsigned long version = 0;   // Graph version the answer is valid for
+    int distance = -1;           // -1 when the target is unreachable
+    vector<int> nodes;           // Empty when the target is unreachable
+};
+
+// Bounded LRU cache of shortest-path results, keyed by
+// (source, target, algorithm, graph version).
+class PathCache {
+public:
+    explicit PathCache(size_t capacity = 1024);
+
+    // Copies only carry the capacity over; cached entries belong to one graph
+    PathCache(const PathCache& other);
+    PathCache& operator=(const PathCache& other);
+
+    bool lookup(int source, int target, PathAlgorithm algorithm,
+                unsigned long version, CachedPath& result);
+    void store(const CachedPath& entry);
+
+    // Re-tag every entry valid at fromVersion as valid at toVersion,
+    // dropping the ones isStale rejects (and anything older)
+    void advance(unsigned long fromVersion, unsigned long toVersion,
+                 const function<bool(const CachedPath&)>& isStale);
+    void clear();
+
+    size_t hits() const;
+    size_t misses() const;
+    size_t size() const;
+
+private:
+    struct Key {
+        int source;
+        int target;
+        PathAlgorithm algorithm;
+        bool operator==(const Key& other) const {
+            return source == other.source && target == other.target && algorithm == other.algorithm;
+        }
+    };
+    struct KeyHash {
+        size_t operator()(const Key& key) const {
+            size_t h = hash<int>()(key.source);
+            h = h * 31 + hash<int>()(key.target);
+            return h * 31 + static_cast<size_t>(key.algorithm);
+        }
+    };
+
+    size_t capacity;
+    list<CachedPath> entries;  // Most recently used first
+    unordered_map<Key, list<CachedPath>::iterator, KeyHash> index;
+    size_t hitCount = 0;
+    size_t missCount = 0;
+    mutable mutex cacheMutex;
+};
+
+#endif
@@ -0,0 +1,56 @@
+#ifndef PATH_ENGINE_HPP
+#define PATH_ENGINE_HPP
+
+#include "Graph.hpp"
+#include "PathCache.hpp"
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// Outcome of one point-to-point query
+struct PathResult {
+    int distance = -1;          // -1 when the target is unreachable
+    vector<int> nodes;          // City ids from source to target
+    size_t settled = 0;         // Cities taken off the queue; 0 for cache hits
+    double milliseconds = 0;    // Wall time of the query
+    bool fromCache = false;
+    bool ruledOut = false;      // Rejected by the reachability labels, without a search
+
+    bool found() const { return distance >= 0; }
+};
+
+// The one shortest-path implementation behind every front end.
+// Searches run on the graph's CSR snapshot and never print;
+// the CLI and GUI decide how to present the result.
+class PathEngine {
+public:
+    static PathResult find(const Graph& graph, const string& startCity, const string& endCity,
+                           PathAlgorithm algorithm = PathAlgorithm::Dijkstra);
+    static PathResult find(const Graph& graph, int source, int target,
+                           PathAlgorithm algorithm = PathAlgorithm::Dijkstra);
+
+    // Plain point-to-point Dijkstra over the CSR snapshot, with no reachability
+    // pre-check, cache or timing; the reference the benchmarks time themselves
+    static PathResult dijkstra(const CompactGraph& graph, int source, int target);
+
+    // Full shortest-path tree from source over the CSR snapshot: distance
+    // (INT_MAX if unreachable) and tree parent (-1 for the source and unreached) per city id
+    static void shortestPathTree(const CompactGraph& graph, int source,
+                                 vector<int>& distance, vector<int>& parent);
+
+    // Paths stay as city ids; names are only looked up when shown.
+    static vector<string> cityNames(const Graph& graph, const PathResult& result);
+    // "A -> B -> C" written straight from the ids, without a vector of names
+    static string formatPath(const Graph& graph, const vector<int>& nodes,
+                             const string& separator = " -> ");
+
+    static string algorithmName(PathAlgorithm algorithm);
+
+private:
+    // heuristic is empty for plain Dijkstra
+    static void search(const CompactGraph& graph, int source, int target,
+                       const vector<int>& heuristic, PathResult& result);
+};
+
+#endif
@@ -0,0 +1,38 @@
+#ifndef REACHABILITY_INDEX_HPP
+#define REACHABILITY_INDEX_HPP
+
+#include "StrongComponents.hpp"
+#include <memory>
+#include <vector>
+
+using namespace std;
+
+// "Can A reach B at all?" without a route search. GRAIL interval labels
+// (Yildirim, Chaoji & Zaki) over the condensation DAG: each of a few randomized
+// DFS passes gives every component the interval [lowest rank below it, its own
+// post-order rank]. If A reaches B, B's interval nests in A's in every pass,
+// so one non-nesting interval proves there is no path. Built in O(LABELINGS * (V + E)).
+class ReachabilityIndex {
+public:
+    static constexpr int LABELINGS = 3;
+
+    static ReachabilityIndex build(shared_ptr<const StrongComponents> components);
+
+    // O(LABELINGS). False only when target provably cannot be reached from source.
+    bool mayReach(int source, int target) const;
+
+    // Exact. Most negative answers come straight from the labels; the rest,
+    // and positive answers, take a DFS over the DAG that skips every component
+    // whose intervals cannot contain the target. Safe to call from several threads.
+    bool reaches(int source, int target) const;
+
+private:
+    // Whether component from's intervals contain component to's in every pass
+    bool nests(int from, int to) const;
+
+    shared_ptr<const StrongComponents> components;
+    vector<int> low;    // LABELINGS entries per component
+    vector<int> rank;
+};
+
+#endif
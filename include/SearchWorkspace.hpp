@@ -0,0 +1,76 @@
+#ifndef SEARCH_WORKSPACE_HPP
+#define SEARCH_WORKSPACE_HPP
+
+#include <vector>
+#include <algorithm>
+#include <functional>
+#include <climits>
+
+using namespace std;
+
+// Distance/parent arrays and heap reused across Dijkstra-style searches.
+// Entries are stamped with the search that wrote them, so starting a new
+// search is O(1) and a search only pays for the cities it reaches.
+class SearchWorkspace {
+public:
+    void begin(int nodeCount) {
+        if (static_cast<int>(stamp.size()) < nodeCount) {
+            dist.resize(nodeCount);
+            parent.resize(nodeCount);
+            stamp.resize(nodeCount, 0);
+        }
+        if (++generation == 0) {
+            // Stamps wrapped around; forget everything once
+            fill(stamp.begin(), stamp.end(), 0);
+            generation = 1;
+        }
+        reached.clear();
+        heap.clear();
+    }
+
+    // INT_MAX / -1 for cities this search has not reached
+    int distance(int node) const { return stamp[node] == generation ? dist[node] : INT_MAX; }
+    int parentOf(int node) const { return stamp[node] == generation ? parent[node] : -1; }
+
+    void set(int node, int distance, int parentNode) {
+        if (stamp[node] != generation) {
+            stamp[node] = generation;
+            reached.push_back(node);
+        }
+        dist[node] = distance;
+        parent[node] = parentNode;
+    }
+
+    // Every city given a distance by this search, in first-reached order
+    const vector<int>& reachedNodes() const { return reached; }
+
+    // Min-heap of (key, node)
+    void push(int key, int node) {
+        heap.push_back({key, node});
+        push_heap(heap.begin(), heap.end(), greater<pair<int, int>>());
+    }
+    pair<int, int> pop() {
+        pop_heap(heap.begin(), heap.end(), greater<pair<int, int>>());
+        pair<int, int> top = heap.back();
+        heap.pop_back();
+        return top;
+    }
+    const pair<int, int>& top() const { return heap.front(); }
+    bool empty() const { return heap.empty(); }
+
+    // One workspace per thread, shared by every search on that thread
+    static SearchWorkspace& local() {
+        thread_local SearchWorkspace workspace;
+        return workspace;
+    }
+
+private:
+    vector<int> dist;
+    vector<int> parent;
+    vector<unsigned> stamp;
+    unsigned generation = 0;
+    vector<int> reached;
+    vector<pair<int, int>> heap;
+};
+
+#endif
@@ -0,0 +1,34 @@
+#ifndef SERVICE_REGIONS_HPP
+#define SERVICE_REGIONS_HPP
+
+#include "Graph.hpp"
+#include <string>
+#include <vector>
+#include <climits>
+
+using namespace std;
+
+// A depot or driver; offset is a head start cost added to every distance from it
+struct Facility {
+    int city;
+    int offset = 0;
+};
+
+// Per city id: which facility serves it and how far away it is
+struct ServiceAssignment {
+    vector<int> nearest;    // Index into the facility list, -1 if no facility reaches the city
+    vector<int> distance;   // INT_MAX if no facility reaches the city
+};
+
+// Multi-source Dijkstra: every facility is queued at its offset and one pass
+// labels each city with its closest facility (Voronoi-style service regions).
+// Ties go to the facility listed first.
+class ServiceRegions {
+public:
+    static void findNearest(Graph& graph);  // Interactive CLI entry point
+
+    static ServiceAssignment assign(const CompactGraph& graph, const vector<Facility>& facilities);
+    static ServiceAssignment assign(const Graph& graph, const vector<string>& facilityCities);
+};
+
+#endif
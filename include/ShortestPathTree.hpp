@@ -0,0 +1,73 @@
+#ifndef SHORTEST_PATH_TREE_HPP
+#define SHORTEST_PATH_TREE_HPP
+
+#include "Graph.hpp"
+#include "GraphObserver.hpp"
+#include <string>
+#include <vector>
+#include <climits>
+
+using namespace std;
+
+// Shortest-path tree from one source that stays correct while the graph is
+// edited. Edge insertions and decreases propagate improvements forward;
+// deletions and increases of tree edges only recompute the affected subtree
+// (Ramalingam & Reps). Edits off the tree cost nothing.
+// The initial tree comes from PathEngine over the CSR snapshot; afterwards
+// the tree is kept by city id and edits are translated with cityId().
+class ShortestPathTree : public GraphObserver {
+public:
+    ShortestPathTree(Graph& graph, const string& sourceCity);
+    ~ShortestPathTree() override;
+
+    ShortestPathTree(const ShortestPathTree&) = delete;
+    ShortestPathTree& operator=(const ShortestPathTree&) = delete;
+
+    const string& source() const { return sourceCity; }
+    // False once the source city has been deleted or the graph cleared
+    bool isValid() const { return valid; }
+
+    // -1 if the city is unreachable
+    int distanceTo(const string& city) const;
+    // City ids from the source; empty if the city is unreachable
+    vector<int> pathTo(const string& city) const;
+
+    // Number of cities whose distance was recomputed by the last edit
+    size_t lastRepairSize() const { return repaired; }
+
+    void onEdgeAdded(const string& from, const string& to, int distance) override;
+    void onEdgeRemoved(const string& from, const string& to, int distance) override;
+    void onEdgeWeightChanged(const string& from, const string& to, int oldDistance, int newDistance) override;
+    void onCityRemoved(const string& city, int id) override;
+    void onGraphCleared() override;
+
+private:
+    static constexpr int UNREACHED = INT_MAX;
+
+    void rebuild();
+    void reset();
+    // Cities added after the tree was built get slots on first mention
+    void ensureSlot(int city);
+    bool reached(int city) const { return city >= 0 && city < static_cast<int>(dist.size()) && dist[city] != UNREACHED; }
+    void setParent(int city, int parentCity);
+    void detach(int city);
+    // Lower dist[to] through from if that is shorter, then propagate
+    void improve(int from, int to, int distance);
+    // Recompute the subtrees rooted at the given cities
+    void repairSubtrees(const vector<int>& roots);
+    // Live out/in connections of a city as (city id, distance)
+    vector<pair<int, int>> connections(int city, bool outgoing) const;
+
+    Graph& graph;
+    string sourceCity;
+    int sourceId = -1;
+    bool valid = true;
+    size_t repaired = 0;
+
+    vector<int> dist;                // UNREACHED outside the tree
+    vector<int> parent;              // Tree edge into each reached city, -1 elsewhere
+    vector<vector<int>> children;
+    vector<char> affected;           // Scratch marks for repairSubtrees
+};
+
+#endif
@@ -0,0 +1,40 @@
+#ifndef STRONG_COMPONENTS_HPP
+#define STRONG_COMPONENTS_HPP
+
+#include "CompactGraph.hpp"
+#include <vector>
+
+using namespace std;
+
+// Strongly connected components (iterative Tarjan) and their condensation DAG.
+// Components are numbered in reverse topological order, so every DAG edge goes
+// from a higher component id to a lower one.
+class StrongComponents {
+public:
+    static StrongComponents build(const CompactGraph& graph);
+
+    int componentCount() const { return static_cast<int>(sizes.size()); }
+    // -1 for dead slots
+    int componentOf(int node) const { return component[node]; }
+    int componentSize(int id) const { return sizes[id]; }
+    int largestComponent() const { return largest; }
+
+    // O(1). False only when target provably cannot be reached from source:
+    // a dead city, a component later in topological order, or a DAG level
+    // (longest chain from a source or to a sink) that rules a path out.
+    bool mayReach(int source, int target) const;
+
+    // Condensation DAG over component ids, without repeated edges.
+    // Edges of component c are [dagOffsets[c], dagOffsets[c + 1]).
+    vector<int> dagOffsets;
+    vector<int> dagTargets;
+
+private:
+    vector<int> component;
+    vector<int> sizes;
+    vector<int> depth;    // Longest DAG path from a source component
+    vector<int> height;   // Longest DAG path to a sink component
+    int largest = -1;
+};
+
+#endif
@@ -0,0 +1,51 @@
+#ifndef THREAD_POOL_HPP
+#define THREAD_POOL_HPP
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+
+using namespace std;
+
+// Fixed set of worker threads that run index ranges in parallel.
+// parallelFor is not reentrant: a task must not call back into its own pool.
+class ThreadPool {
+public:
+    explicit ThreadPool(unsigned threadCount = thread::hardware_concurrency());
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    unsigned size() const { return static_cast<unsigned>(workers.size()); }
+
+    // Run task(index, worker) for every index in [0, count) and wait for completion.
+    // Indices are handed out in blocks of grain; worker is in [0, size()).
+    void parallelFor(size_t count, const function<void(size_t, unsigned)>& task, size_t grain = 1);
+
+    // Process-wide pool sized to the hardware
+    static ThreadPool& shared();
+
+private:
+    void workerLoop(unsigned worker);
+
+    vector<thread> workers;
+    mutex callerMutex;  // One parallelFor at a time
+    mutex poolMutex;
+    condition_variable wakeUp;
+    condition_variable jobDone;
+
+    // Current job, published under poolMutex
+    const function<void(size_t, unsigned)>* job = nullptr;
+    size_t jobCount = 0;
+    size_t jobGrain = 1;
+    unsigned long jobGeneration = 0;
+    atomic<size_t> nextIndex{0};
+    unsigned busyWorkers = 0;
+    bool stopping = false;
+};
+
+#endif
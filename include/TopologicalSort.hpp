@@ -0,0 +1,37 @@
+#ifndef TOPOLOGICAL_SORT_HPP
+#define TOPOLOGICAL_SORT_HPP
+
+#include "CompactGraph.hpp"
+#include <vector>
+#include <utility>
+
+using namespace std;
+
+// Result of a layered topological sort
+struct Layering {
+    vector<int> order;                    // Every live node, each after all its non-feedback predecessors
+    vector<int> layer;                    // Longest-path layer per node, -1 for dead slots
+    int layerCount = 0;
+    vector<pair<int, int>> feedbackArcs;  // (from, to) edges ignored to break cycles
+
+    bool acyclic() const { return feedbackArcs.empty(); }
+};
+
+// Kahn's algorithm over a bucket queue of remaining in-degrees. While some
+// node has no unprocessed predecessors it is taken next, exactly as in Kahn;
+// when only cycles remain, the node with the fewest is taken instead and
+// those incoming edges become feedback arcs. Layers are longest paths over
+// the remaining DAG, so every kept edge goes at least one layer down.
+// O(V + E) either way.
+class TopologicalSort {
+public:
+    static Layering layers(const CompactGraph& graph);
+    // Nodes 0..successors.size()-1, all live; e.g. a layout's own adjacency
+    static Layering layers(const vector<vector<int>>& successors);
+
+private:
+    static Layering layers(int nodeCount, const vector<int>& offsets, const vector<int>& targets,
+                           const vector<char>& alive);
+};
+
+#endif
@@ -2,14 +2,44 @@
 #define TRAVERSAL_HPP
 
 #include "Graph.hpp"
+#include "CompactGraph.hpp"
+#include "ThreadPool.hpp"
+#include "TraversalCursor.hpp"
 #include <string>
-#include <stack>
-#include <queue>
-#include <unordered_set>
 #include <vector>
+#include <functional>
 
 using namespace std;
 
+// Unweighted BFS tree over city ids; -1 marks unreached cities (and the source's parent)
+struct HopTree {
+    vector<int> hops;
+    vector<int> parent;
+    int levels = 0;          // Frontier expansions that reached new cities
+    int bottomUpLevels = 0;  // Of those, how many ran bottom-up
+};
+
+// Edge of a DFS/BFS spanning tree, with its distance
+struct TreeEdge {
+    int parent;
+    int child;
+    int distance;
+};
+
+// Visit order and spanning tree of one traversal, over city ids
+struct TraversalTree {
+    vector<int> order;
+    vector<int> parent;       // Per city id, -1 for the source and unreached cities
+    vector<TreeEdge> edges;   // In the order the children were reached
+};
+
+// Cities reached by a BFS, grouped by level
+struct LevelOrder {
+    vector<int> order;       // City ids; level k is order[levelStart[k], levelStart[k + 1])
+    vector<int> levelStart;
+    vector<int> level;       // Per city id, -1 if unreached
+};
+
 class Traversal {
 public:
     static void traverse(Graph& graph);
@@ -21,6 +51,42 @@ public:
     static void dfsWithPath(const Graph& graph, const string& startCity, vector<string>& path);
     static void bfsWithPath(const Graph& graph, const string& startCity, vector<string>& path);
 
+    // Visit order over city ids, neighbors taken in adjacency order.
+    // Empty if source is not a live city.
+    static vector<int> dfsOrder(const CompactGraph& graph, int source);
+    static vector<int> bfsOrder(const CompactGraph& graph, int source);
+
+    // The same walks, also recording the tree edge each city was reached by
+    static TraversalTree dfsTree(const CompactGraph& graph, int source);
+    static TraversalTree bfsTree(const CompactGraph& graph, int source);
+
+    // Direction-optimizing BFS (Beamer et al.): expands the frontier top-down over
+    // outgoing edges while it is small, and bottom-up over incoming edges of the
+    // unvisited cities once the frontier's edges outnumber theirs / ALPHA. Returns
+    // to top-down when the frontier drops below nodeCount / BETA cities.
+    static HopTree hopDistances(const CompactGraph& graph, int source);
+    static void showHopDistances(Graph& graph, const string& startCity);
+
+    static constexpr int ALPHA = 15;
+    static constexpr int BETA = 18;
+
+    // Level-synchronous BFS with each frontier split across the pool. Workers claim
+    // cities with an atomic test-and-set and collect the next frontier in their own
+    // buffers, which are concatenated at the end of the level. Within a level the
+    // order then depends on scheduling; deterministic gives exactly bfsOrder instead,
+    // at the cost of a second pass over the frontier's edges.
+    static LevelOrder parallelBfs(const CompactGraph& graph, int source, ThreadPool& pool,
+                                  bool deterministic = false);
+
+    // Graphs at least this large are traversed by parallelBfs in bfsWithPath
+    static constexpr int PARALLEL_BFS_CITIES = 100000;
+
+    // Nearest city (fewest hops) from source that matches, e.g. the first reachable
+    // depot. The BFS stops there. node is -1 if no reachable city matches.
+    static TraversalStep firstReachable(const Graph& graph, int source, const function<bool(int)>& matches);
+
+private:
+    static vector<string> cityNames(const Graph& graph, const vector<int>& order);
 };
 
 #endif
@@ -0,0 +1,53 @@
+#ifndef TRAVERSAL_CURSOR_HPP
+#define TRAVERSAL_CURSOR_HPP
+
+#include "CompactGraph.hpp"
+#include "NodeBitset.hpp"
+#include <vector>
+#include <memory>
+#include <utility>
+
+using namespace std;
+
+// One visited city; parent is -1 for the start city
+struct TraversalStep {
+    int node = -1;
+    int depth = 0;
+    int parent = -1;
+};
+
+// DFS or BFS that produces one city per next() call, in the same order as
+// Traversal::dfsOrder / bfsOrder. Nothing is computed ahead of the caller,
+// so it can be paused between calls or dropped as soon as it has found what
+// it was looking for. The cursor keeps its graph snapshot alive, so later
+// edits to the Graph do not affect a traversal in progress.
+class TraversalCursor {
+public:
+    enum class Order { DepthFirst, BreadthFirst };
+
+    TraversalCursor(shared_ptr<const CompactGraph> graph, int source, Order order);
+
+    // False once every reachable city has been produced
+    bool next(TraversalStep& step);
+
+    Order order() const { return visitOrder; }
+    size_t visitedCount() const { return visited; }
+
+private:
+    bool nextDepthFirst(TraversalStep& step);
+    bool nextBreadthFirst(TraversalStep& step);
+
+    shared_ptr<const CompactGraph> graph;
+    Order visitOrder;
+    NodeBitset seen;
+    size_t visited = 0;
+    int start = -1;   // DFS start city, until it has been produced
+
+    // DFS: the current branch, one (city, next edge) frame per level
+    vector<pair<int, int>> stack;
+    // BFS: discovered cities waiting to be produced; queue[head] is next
+    vector<TraversalStep> queue;
+    size_t head = 0;
+};
+
+#endif
@@ -0,0 +1,55 @@
+#ifndef VERSIONED_SLOT_HPP
+#define VERSIONED_SLOT_HPP
+
+#include <memory>
+#include <mutex>
+#include <functional>
+
+using namespace std;
+
+// Holds one derived structure for a single graph version and rebuilds it
+// on demand once the graph has moved on. Copies start out empty.
+template <typename T>
+class VersionedSlot {
+public:
+    VersionedSlot() = default;
+    VersionedSlot(const VersionedSlot&) {}
+    VersionedSlot& operator=(const VersionedSlot&) {
+        reset();
+        return *this;
+    }
+
+    shared_ptr<const T> get(unsigned long version, const function<shared_ptr<const T>()>& build) {
+        lock_guard<mutex> guard(slotMutex);
+        if (!value || builtFor != version) {
+            value = build();
+            builtFor = version;
+        }
+        return value;
+    }
+
+    // Current value if it was built for this version, otherwise null
+    shared_ptr<const T> peek(unsigned long version) const {
+        lock_guard<mutex> guard(slotMutex);
+        return builtFor == version ? value : nullptr;
+    }
+
+    // Install a value computed elsewhere (e.g. loaded from disk)
+    void set(unsigned long version, shared_ptr<const T> newValue) {
+        lock_guard<mutex> guard(slotMutex);
+        value = move(newValue);
+        builtFor = version;
+    }
+
+    void reset() {
+        lock_guard<mutex> guard(slotMutex);
+        value.reset();
+    }
+
+private:
+    shared_ptr<const T> value;
+    unsigned long builtFor = 0;
+    mutable mutex slotMutex;
+};
+
+#endif
@@ -27,12 +27,24 @@
 #include <QShowEvent>
 #include <QApplication>
 #include <QRandomGenerator>
+#include <QVector>
+#include <QCheckBox>
 
 #include "../Graph.hpp"
 #include "../IOManager.hpp"
 #include "../Traversal.hpp"
+#include "../TraversalCursor.hpp"
 #include "../Dijkstra.hpp"
 #include "../AStar.hpp"
+#include "../ShortestPathTree.hpp"
+#include "../PathEngine.hpp"
+#include "../Isochrone.hpp"
+#include "../ServiceRegions.hpp"
+#include "../TopologicalSort.hpp"
+#include "../MinimumSpanning.hpp"
+#include "../Centrality.hpp"
+#include "../MaxFlow.hpp"
+#include <memory>
 
 class QGraphicsScene;
 class QGraphicsView;
@@ -92,15 +104,25 @@ private slots:
     // Edge operations
     void addEdge();
     void deleteEdge();
+    void updateEdgeDistance();
     
     // Traversal operations
     void performDFS();
     void performBFS();
-    void visualizeSpanningTree(const vector<string>& path, const vector<pair<string, string>>& treeEdges, bool isDFS);
+    // Show the next city of the animated traversal
+    void advanceTraversal();
+    // Colour every city by its strongly connected component
+    void showStrongComponents();
+    // Draw only the given cities and tree edges, under a title
+    void visualizeSpanningTree(const vector<int>& nodes, const vector<TreeEdge>& edges, const QString& title);
     
     // Pathfinding operations
     void findDijkstraPath();
     void findAStarPath();
+    void showIsochrone();
+    void showServiceRegions();
+    // Maximum flow between "From" and "To"; marks the roads of the minimum cut
+    void showMinCut();
     
     // Node interaction handling
     void handleNodeDragFinished();
@@ -116,6 +138,18 @@ private:
     Graph graph;
     IOManager ioManager;
     
+    // Highlighted Dijkstra route, kept up to date as the graph is edited
+    unique_ptr<ShortestPathTree> activeRoute;
+    QString activeRouteTarget;
+    
+    // Animated traversal, one city per timer tick; any redraw ends it
+    unique_ptr<TraversalCursor> traversalCursor;
+    QTimer *traversalTimer = nullptr;
+    
+    // Distance betweenness for node sizes, recomputed when the graph version moves on
+    shared_ptr<const CentralityScores> centrality;
+    unsigned long centralityVersion = 0;
+    
     // Theme tracking
     bool isDarkMode;
     
@@ -135,6 +169,7 @@ private:
     
     // Node tracking
     QMap<QString, DraggableNode*> nodeItems;
+    QVector<DraggableNode*> nodesById;   // Indexed by city id, null where nothing is drawn
     
     // City management group
     QLineEdit *cityNameInput;
@@ -147,17 +182,26 @@ private:
     QLineEdit *distanceInput;
     QPushButton *addEdgeButton;
     QPushButton *deleteEdgeButton;
+    QPushButton *updateEdgeButton;
     
     // Traversal group
     QLineEdit *startCityInput;
     QPushButton *dfsButton;
     QPushButton *bfsButton;
+    QCheckBox *animateTraversalCheck;
+    QPushButton *componentsButton;
+    QCheckBox *sizeByCentralityCheck;
     
     // Pathfinding group
     QLineEdit *pathFromInput;
     QLineEdit *pathToInput;
     QPushButton *dijkstraButton;
     QPushButton *aStarButton;
+    QLineEdit *budgetInput;
+    QPushButton *isochroneButton;
+    QLineEdit *facilitiesInput;
+    QPushButton *serviceRegionsButton;
+    QPushButton *minCutButton;
     
     // Menu components
     QAction *saveAction;
@@ -171,9 +215,25 @@ private:
     void createOptionsPanel();
     void createLogPanel();
     
+    void startTraversal(TraversalCursor::Order order, const QString &startCity);
+    // DFS or BFS tree from the starting city input
+    void showSpanningTree(bool isDFS);
+    // Minimum spanning forest, or the minimum arborescence from the starting city
+    void showMinimumSpanning(bool arborescence);
+    void stopTraversal();
+    
     void updateGraphDisplay();
-    void updateGraphDisplay(const QString &highlightPath);
+    // Highlight a path given as city ids
+    void updateGraphDisplay(const vector<int> &highlightPath);
+    // "A -> B -> C" for a path of city ids
+    QString pathLabel(const vector<int> &path) const;
+    // Redraw after an edit, re-highlighting the active route if there is one
+    void refreshDisplay();
+    // Highlight a path found by PathEngine and log its cost
+    void showPathResult(PathAlgorithm algorithm, const PathResult& result);
     void updateEdgesForNode(const QString &nodeName);
+    // Centrality of the current graph version, sampled on large graphs
+    const CentralityScores& currentCentrality();
     
     void logMessage(const QString &message);
     
@@ -1,8 +1,6 @@
 #include "../include/AStar.hpp"
 #include "../include/Graph.hpp"
 #include <iostream>
-#include <algorithm>
-#include <limits>
 using namespace std;
 #include <cmath> // for sqrt, pow
 
@@ -16,126 +14,70 @@ unordered_map<string, pair<int, int>> cityCoords = {
     // TODO add The cities here
 };
 
-// Factory function to remap adjacency list to city coordinates
-unordered_map<string, pair<int, int>> remapAdjList(const Graph& graph) {
-  unordered_map<string, pair<int, int>> newCoords;
-  const auto& adjList = graph.getAdjList();
-  
-  // Initialize with existing coordinates when available
-  for (const auto& [city, _] : adjList) {
-    if (cityCoords.find(city) != cityCoords.end()) {
-      newCoords[city] = cityCoords[city];
-    } else {
-      // Assign default coordinates for cities not in the original map
-      // This is a simple strategy - in a real implementation, you might
-      // want to use a more sophisticated approach to place cities
-      newCoords[city] = {0, 0};
-    }
-  }
-  
-  return newCoords;
+// Cities missing from the table sit at the origin
+static pair<int, int> coordinatesOf(const string &city)
+{
+  auto known = cityCoords.find(city);
+  return known != cityCoords.end() ? known->second : make_pair(0, 0);
 }
 
-int AStar::heuristic(Graph& graph, const string &a, const string &b)
+int AStar::heuristic(const string &a, const string &b)
 {
-  auto coords = remapAdjList(graph);
-  
-  if (coords.find(a) == coords.end() || coords.find(b) == coords.end())
-  {
-    return 0; // meaning A* behaves like Dijkstra
-  }
-
-  auto [x1, y1] = coords[a];
-  auto [x2, y2] = coords[b];
+  auto [x1, y1] = coordinatesOf(a);
+  auto [x2, y2] = coordinatesOf(b);
 
   return static_cast<int>(sqrt(pow(x1 - x2, 2) + pow(y1 - y2, 2))); // Euclidean distance
 }
 
-vector<string> AStar::findPath(Graph &graph, const string &startCity, const string &goalCity)
+vector<int> AStar::estimatesTo(const Graph &graph, int goal)
 {
-  const auto &adjList = graph.getAdjList();
-
-  if (adjList.find(startCity) == adjList.end() || adjList.find(goalCity) == adjList.end())
+  // One estimate per city id, computed once per query rather than per relaxation
+  auto compact = graph.compact();
+  vector<int> estimates(compact->nodeCount(), 0);
+  const string &goalCity = graph.cityName(goal);
+  for (int id = 0; id < compact->nodeCount(); id++)
   {
-    cout << "Start or goal city not found in the graph.\n";
-    return {};
+    if (compact->isAlive(id))
+    {
+      estimates[id] = heuristic(graph.cityName(id), goalCity);
+    }
   }
+  return estimates;
+}
 
-  unordered_map<string, int> gScore;
-  unordered_map<string, int> fScore;
-  unordered_map<string, string> cameFrom;
-
-  for (const auto &[city, _] : adjList)
+vector<string> AStar::findPath(Graph &graph, const string &startCity, const string &goalCity)
+{
+  if (!graph.cityExists(startCity) || !graph.cityExists(goalCity))
   {
-    gScore[city] = numeric_limits<int>::max();
-    fScore[city] = numeric_limits<int>::max();
+    cout << "Start or goal city not found in the graph.\n";
+    return {};
   }
 
-  gScore[startCity] = 0;
-  fScore[startCity] = heuristic(graph, startCity, goalCity);
-
-  using PQElement = pair<int, string>; // (fScore, city)
-  priority_queue<PQElement, vector<PQElement>, greater<>> openSet;
-  openSet.push({fScore[startCity], startCity});
-
-  while (!openSet.empty())
+  PathResult result = PathEngine::find(graph, startCity, goalCity, PathAlgorithm::AStar);
+  if (!result.found())
   {
-    string current = openSet.top().second;
-    openSet.pop();
-
-    if (current == goalCity)
-    {
-      vector<string> path = reconstructPath(cameFrom, startCity, goalCity);
-
-      // Calculate total cost from gScore map
-      int totalCost = gScore[goalCity];
-
-      displayPath(path, totalCost);
-      return path;
-    }
-
-    for (const auto &[neighbor, dist] : adjList.at(current))
+    cout << "No path found.\n";
+    if (result.ruledOut)
     {
-      int tentative_gScore = gScore[current] + dist;
-      if (tentative_gScore < gScore[neighbor])
-      {
-        cameFrom[neighbor] = current;
-        gScore[neighbor] = tentative_gScore;
-        fScore[neighbor] = tentative_gScore + heuristic(graph, neighbor, goalCity);
-        openSet.push({fScore[neighbor], neighbor});
-      }
+      cout << "(the one-way structure of the network rules it out; no search was needed)\n";
     }
+    return {};
   }
 
-  cout << "No path found.\n";
-  return {};
+  displayPath(graph, result);
+  return PathEngine::cityNames(graph, result);
 }
 
-vector<string> AStar::reconstructPath(const unordered_map<string, string> &cameFrom,
-                                      const string &startCity,
-                                      const string &goalCity)
+void AStar::displayPath(const Graph &graph, const PathResult &result)
 {
-  vector<string> path;
-  string current = goalCity;
-  while (current != startCity)
+  cout << "\nShortest Path Found (A*):\n";
+  cout << "Total Cost: " << result.distance << "\nPath: " << PathEngine::formatPath(graph, result.nodes) << "\n";
+  if (result.fromCache)
   {
-    path.push_back(current);
-    current = cameFrom.at(current);
+    cout << "(answered from the path cache)\n";
   }
-  path.push_back(startCity);
-  reverse(path.begin(), path.end());
-  return path;
-}
-
-void AStar::displayPath(const vector<string> &path, int totalCost)
-{
-  cout << "\nShortest Path Found (A*):\n";
-  cout << "Total Cost: " << totalCost << "\nPath: ";
-  for (size_t i = 0; i < path.size(); i++)
+  else
   {
-    cout << path[i];
-    if (i < path.size() - 1)
-      cout << " -> ";
+    cout << "Settled " << result.settled << " cities in " << result.milliseconds << " ms\n";
   }
-  cout << "\n";
-}
\ No newline at end of file
+}
@@ -0,0 +1,261 @@
+#include "../include/ArcFlags.hpp"
+#include "../include/Graph.hpp"
+#include <atomic>
+#include <queue>
+#include <cmath>
+#include <climits>
+#include <fstream>
+#include <sstream>
+#include <iostream>
+#include <stdexcept>
+#include <algorithm>
+
+using namespace std;
+
+// Split the nodes into equal runs of a breadth-first order over the
+// undirected view, which keeps each region mostly connected.
+void ArcFlags::partition(const CompactGraph& graph, int regionCount, vector<int>& region) {
+    int n = graph.nodeCount();
+    region.assign(n, -1);
+
+    vector<int> order;
+    order.reserve(graph.liveCount);
+    vector<char> seen(n, 0);
+    for (int start = 0; start < n; ++start) {
+        if (!graph.isAlive(start) || seen[start]) {
+            continue;
+        }
+        size_t head = order.size();
+        order.push_back(start);
+        seen[start] = 1;
+        while (head < order.size()) {
+            int u = order[head++];
+            for (int e = graph.offsets[u]; e < graph.offsets[u + 1]; ++e) {
+                if (!seen[graph.targets[e]]) {
+                    seen[graph.targets[e]] = 1;
+                    order.push_back(graph.targets[e]);
+                }
+            }
+            for (int i = graph.inOffsets[u]; i < graph.inOffsets[u + 1]; ++i) {
+                if (!seen[graph.sources[i]]) {
+                    seen[graph.sources[i]] = 1;
+                    order.push_back(graph.sources[i]);
+                }
+            }
+        }
+    }
+
+    size_t chunk = (order.size() + regionCount - 1) / regionCount;
+    for (size_t i = 0; i < order.size(); ++i) {
+        region[order[i]] = static_cast<int>(i / max<size_t>(1, chunk));
+    }
+}
+
+ArcFlags ArcFlags::build(const CompactGraph& graph, int regionCount, ThreadPool& pool) {
+    if (regionCount <= 0) {
+        regionCount = static_cast<int>(sqrt(static_cast<double>(graph.liveCount)));
+    }
+    ArcFlags result;
+    result.regions = max(1, min(MAX_REGIONS, regionCount));
+    partition(graph, result.regions, result.region);
+
+    int n = graph.nodeCount();
+    int m = graph.edgeCount();
+    vector<atomic<uint64_t>> flags(m);
+    vector<int> boundary;
+
+    for (int u = 0; u < n; ++u) {
+        for (int e = graph.offsets[u]; e < graph.offsets[u + 1]; ++e) {
+            int v = graph.targets[e];
+            // Edges inside a region always lead towards it
+            flags[e].store(result.region[u] == result.region[v] ? (1ULL << result.region[v]) : 0,
+                           memory_order_relaxed);
+        }
+    }
+
+    // Boundary nodes are the entry points of their region
+    for (int v = 0; v < n; ++v) {
+        for (int i = graph.inOffsets[v]; i < graph.inOffsets[v + 1]; ++i) {
+            if (result.region[graph.sources[i]] != result.region[v]) {
+                boundary.push_back(v);
+                break;
+            }
+        }
+    }
+
+    // One backward search per boundary node: an edge (u, v) is on a shortest
+    // path into the node exactly when dist(u) == w + dist(v)
+    vector<vector<int>> distance(pool.size(), vector<int>(n, INT_MAX));
+    pool.parallelFor(boundary.size(), [&](size_t index, unsigned worker) {
+        int root = boundary[index];
+        uint64_t bit = 1ULL << result.region[root];
+        vector<int>& dist = distance[worker];
+        vector<int> settled;
+        priority_queue<pair<int, int>, vector<pair<int, int>>, greater<pair<int, int>>> pq;
+
+        dist[root] = 0;
+        pq.push({0, root});
+        while (!pq.empty()) {
+            auto [d, v] = pq.top();
+            pq.pop();
+            if (d > dist[v]) continue;
+            settled.push_back(v);
+            for (int i = graph.inOffsets[v]; i < graph.inOffsets[v + 1]; ++i) {
+                int u = graph.sources[i];
+                int nd = d + graph.weights[graph.inEdges[i]];
+                if (nd < dist[u]) {
+                    dist[u] = nd;
+                    pq.push({nd, u});
+                }
+            }
+        }
+
+        for (int v : settled) {
+            for (int i = graph.inOffsets[v]; i < graph.inOffsets[v + 1]; ++i) {
+                int e = graph.inEdges[i];
+                if (dist[graph.sources[i]] == dist[v] + graph.weights[e] &&
+                    !(flags[e].load(memory_order_relaxed) & bit)) {
+                    flags[e].fetch_or(bit, memory_order_relaxed);
+                }
+            }
+        }
+        for (int v : settled) {
+            dist[v] = INT_MAX;
+        }
+    });
+
+    result.flags.resize(m);
+    for (int e = 0; e < m; ++e) {
+        result.flags[e] = flags[e].load(memory_order_relaxed);
+    }
+    return result;
+}
+
+int ArcFlags::shortestPath(const CompactGraph& graph, int source, int target, vector<int>& nodes,
+                           size_t* settled) const {
+    nodes.clear();
+    int n = graph.nodeCount();
+    if (source < 0 || target < 0 || source >= n || target >= n ||
+        !graph.isAlive(source) || !graph.isAlive(target)) {
+        return -1;
+    }
+
+    uint64_t bit = 1ULL << region[target];
+    vector<int> dist(n, INT_MAX);
+    vector<int> parent(n, -1);
+    priority_queue<pair<int, int>, vector<pair<int, int>>, greater<pair<int, int>>> pq;
+
+    dist[source] = 0;
+    pq.push({0, source});
+    while (!pq.empty()) {
+        auto [d, u] = pq.top();
+        pq.pop();
+        if (d > dist[u]) continue;
+        if (settled) (*settled)++;
+        if (u == target) break;
+
+        for (int e = graph.offsets[u]; e < graph.offsets[u + 1]; ++e) {
+            // Skip edges that never lead towards the target's region
+            if (!(flags[e] & bit)) continue;
+            int v = graph.targets[e];
+            int nd = d + graph.weights[e];
+            if (nd < dist[v]) {
+                dist[v] = nd;
+                parent[v] = u;
+                pq.push({nd, v});
+            }
+        }
+    }
+
+    if (dist[target] == INT_MAX) {
+        return -1;
+    }
+    for (int v = target; v != -1; v = parent[v]) {
+        nodes.push_back(v);
+    }
+    reverse(nodes.begin(), nodes.end());
+    return dist[target];
+}
+
+void ArcFlags::save(const string& filename, const Graph& graph, const CompactGraph& compact) const {
+    ofstream file(filename);
+    if (!file) {
+        string errorMsg = "Error opening file for writing: " + filename;
+        cerr << errorMsg << endl;
+        throw runtime_error(errorMsg);
+    }
+
+    file << "ARCFLAGS " << regions << " " << compact.liveCount << " " << compact.edgeCount() << "\n";
+    for (int u = 0; u < compact.nodeCount(); ++u) {
+        if (compact.isAlive(u)) {
+            file << graph.cityName(u) << " " << region[u] << "\n";
+        }
+    }
+    for (int u = 0; u < compact.nodeCount(); ++u) {
+        for (int e = compact.offsets[u]; e < compact.offsets[u + 1]; ++e) {
+            file << graph.cityName(u) << " " << graph.cityName(compact.targets[e]) << " "
+                 << compact.weights[e] << " " << hex << flags[e] << dec << "\n";
+        }
+    }
+
+    if (!file) {
+        string errorMsg = "Error writing arc-flags to file: " + filename;
+        cerr << errorMsg << endl;
+        throw runtime_error(errorMsg);
+    }
+}
+
+bool ArcFlags::load(const string& filename, const Graph& graph, const CompactGraph& compact, ArcFlags& result) {
+    ifstream file(filename);
+    if (!file) {
+        return false;
+    }
+
+    string header;
+    int regions, cities, edges;
+    if (!(file >> header >> regions >> cities >> edges) || header != "ARCFLAGS" ||
+        regions < 1 || regions > MAX_REGIONS ||
+        cities != compact.liveCount || edges != compact.edgeCount()) {
+        return false;  // Written for a different graph
+    }
+
+    ArcFlags loaded;
+    loaded.regions = regions;
+    loaded.region.assign(compact.nodeCount(), -1);
+    loaded.flags.assign(compact.edgeCount(), 0);
+
+    for (int i = 0; i < cities; ++i) {
+        string city;
+        int region;
+        if (!(file >> city >> region)) return false;
+        int id = graph.cityId(city);
+        // A repeated city would leave another live city without a region
+        if (id < 0 || loaded.region[id] >= 0 || region < 0 || region >= regions) return false;
+        loaded.region[id] = region;
+    }
+
+    vector<char> seen(compact.edgeCount(), 0);
+    for (int i = 0; i < edges; ++i) {
+        string from, to;
+        int weight;
+        uint64_t mask;
+        if (!(file >> from >> to >> weight >> hex >> mask >> dec)) return false;
+        int u = graph.cityId(from);
+        int v = graph.cityId(to);
+        if (u < 0 || v < 0) return false;
+
+        int edge = -1;
+        for (int e = compact.offsets[u]; e < compact.offsets[u + 1]; ++e) {
+            if (compact.targets[e] == v && compact.weights[e] == weight) {
+                edge = e;
+                break;
+            }
+        }
+        if (edge < 0 || seen[edge]) return false;
+        seen[edge] = 1;
+        loaded.flags[edge] = mask;
+    }
+
+    result = move(loaded);
+    return true;
+}
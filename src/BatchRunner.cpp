@@ -0,0 +1,758 @@
+#include "../include/BatchRunner.hpp"
+#include "../include/IOManager.hpp"
+#include "../include/Dijkstra.hpp"
+#include "../include/PathEngine.hpp"
+#include "../include/ThreadPool.hpp"
+#include "../include/DeltaStepping.hpp"
+#include "../include/CustomizedRoutes.hpp"
+#include "../include/Traversal.hpp"
+#include "../include/MultiSourceBfs.hpp"
+#include "../include/MaxFlow.hpp"
+#include "../include/Centrality.hpp"
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <memory>
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <random>
+#include <stack>
+#include <queue>
+#include <unordered_set>
+#include <map>
+#include <cmath>
+#include <climits>
+
+using namespace std;
+
+// Queries held in memory at once, per worker thread
+static const size_t QUERIES_PER_THREAD = 256;
+// Sources the one-at-a-time BFS baselines run in the traversal benchmark
+static const size_t MSBFS_BASELINE_SOURCES = 8;
+
+void BatchRunner::printUsage(const char* program) {
+    cerr << "Usage: " << program << " --graph <file> --queries <file> [--algo dijkstra|astar|arcflags|crp|reach]"
+         << " [--threads N] [--output <file>]\n";
+    cerr << "       " << program << " --graph <file> --bench-sssp <city> [--delta D]\n";
+    cerr << "       " << program << " --graph <file> --bench-crp <queries>\n";
+    cerr << "       " << program << " --graph <file> --bench-traversal <city>\n";
+    cerr << "       " << program << " --bench-flow <size>\n";
+    cerr << "       " << program << " --check centrality\n";
+}
+
+bool BatchRunner::parseArguments(int argc, char* argv[], Options& options) {
+    for (int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+        if (i + 1 >= argc) {
+            cerr << "Missing value for " << arg << "\n";
+            return false;
+        }
+        string value = argv[++i];
+
+        if (arg == "--graph") {
+            options.graphFile = value;
+        } else if (arg == "--queries") {
+            options.queryFile = value;
+        } else if (arg == "--output") {
+            options.outputFile = value;
+        } else if (arg == "--algo") {
+            if (value != "dijkstra" && value != "astar" && value != "arcflags" && value != "crp" &&
+                value != "reach") {
+                cerr << "Unknown algorithm: " << value << "\n";
+                return false;
+            }
+            options.algorithm = value;
+        } else if (arg == "--bench-sssp") {
+            options.benchSource = value;
+        } else if (arg == "--bench-crp") {
+            try {
+                options.crpQueries = stoi(value);
+                if (options.crpQueries < 1) {
+                    throw invalid_argument(value);
+                }
+            } catch (...) {
+                cerr << "Invalid query count: " << value << "\n";
+                return false;
+            }
+        } else if (arg == "--bench-traversal") {
+            options.traversalSource = value;
+        } else if (arg == "--bench-flow") {
+            try {
+                options.flowSize = stoi(value);
+                if (options.flowSize < 2) {
+                    throw invalid_argument(value);
+                }
+            } catch (...) {
+                cerr << "Invalid grid size: " << value << "\n";
+                return false;
+            }
+        } else if (arg == "--check") {
+            if (value != "centrality") {
+                cerr << "Unknown check: " << value << "\n";
+                return false;
+            }
+            options.check = value;
+        } else if (arg == "--delta") {
+            try {
+                options.delta = stoi(value);
+            } catch (...) {
+                cerr << "Invalid delta: " << value << "\n";
+                return false;
+            }
+        } else if (arg == "--threads") {
+            try {
+                int threads = stoi(value);
+                if (threads < 1) {
+                    throw invalid_argument(value);
+                }
+                options.threads = static_cast<unsigned>(threads);
+            } catch (...) {
+                cerr << "Invalid thread count: " << value << "\n";
+                return false;
+            }
+        } else {
+            cerr << "Unknown option: " << arg << "\n";
+            return false;
+        }
+    }
+
+    // The max-flow benchmark and the checks generate their own graphs
+    if (options.flowSize > 0 || !options.check.empty()) {
+        return true;
+    }
+    if (options.graphFile.empty() ||
+        (options.queryFile.empty() && options.benchSource.empty() && options.crpQueries == 0 &&
+         options.traversalSource.empty())) {
+        cerr << "--graph and one of --queries, --bench-sssp, --bench-crp or --bench-traversal "
+             << "(or --bench-flow or --check alone) are required\n";
+        return false;
+    }
+    return true;
+}
+
+string BatchRunner::answerQuery(const Graph& graph, const string& line, const string& algorithm) {
+    // Accept "A,B" as well as "A B"
+    string normalized = line;
+    replace(normalized.begin(), normalized.end(), ',', ' ');
+    istringstream iss(normalized);
+    string from, to;
+    iss >> from >> to;
+
+    from = Graph::standardizeCity(from);
+    to = Graph::standardizeCity(to);
+
+    if (algorithm == "reach") {
+        bool reachable = graph.reachability()->reaches(graph.cityId(from), graph.cityId(to));
+        return from + "," + to + "," + (reachable ? "1" : "0");
+    }
+
+    PathAlgorithm which = algorithm == "astar" ? PathAlgorithm::AStar
+                        : algorithm == "arcflags" ? PathAlgorithm::ArcFlags
+                        : algorithm == "crp" ? PathAlgorithm::Crp
+                        : PathAlgorithm::Dijkstra;
+    PathResult answer = PathEngine::find(graph, from, to, which);
+
+    return from + "," + to + "," + to_string(answer.distance) + "," + PathEngine::formatPath(graph, answer.nodes);
+}
+
+bool BatchRunner::loadGraph(const string& filename, Graph& graph) {
+    // Loading is chatty on stdout; keep results as the only output
+    streambuf* stdoutBuffer = cout.rdbuf(nullptr);
+    bool loaded = true;
+    try {
+        IOManager ioManager;
+        ioManager.loadGraph(filename, graph);
+    } catch (const exception&) {
+        // IOManager has already reported the error on stderr
+        loaded = false;
+    }
+    cout.rdbuf(stdoutBuffer);
+    cout.clear();
+    return loaded;
+}
+
+int BatchRunner::run(int argc, char* argv[]) {
+    Options options;
+    if (!parseArguments(argc, argv, options)) {
+        printUsage(argv[0]);
+        return 1;
+    }
+    if (options.flowSize > 0) {
+        return runFlowBenchmark(options);
+    }
+    if (!options.check.empty()) {
+        return runCentralityCheck();
+    }
+
+    Graph graph;
+    if (!loadGraph(options.graphFile, graph)) {
+        return 1;
+    }
+
+    if (!options.benchSource.empty()) {
+        return runSsspBenchmark(graph, options);
+    }
+    if (options.crpQueries > 0) {
+        return runCrpBenchmark(graph, options);
+    }
+    if (!options.traversalSource.empty()) {
+        return runTraversalBenchmark(graph, options);
+    }
+    return runQueries(graph, options);
+}
+
+int BatchRunner::runQueries(const Graph& graph, const Options& options) {
+    ifstream queries(options.queryFile);
+    if (!queries) {
+        cerr << "Error opening file for reading: " << options.queryFile << endl;
+        return 1;
+    }
+
+    unique_ptr<ofstream> outputFile;
+    if (!options.outputFile.empty()) {
+        outputFile = make_unique<ofstream>(options.outputFile);
+        if (!*outputFile) {
+            cerr << "Error opening file for writing: " << options.outputFile << endl;
+            return 1;
+        }
+    }
+
+    ostream& out = outputFile ? static_cast<ostream&>(*outputFile) : cout;
+    // Build shared derived structures once, before the workers start
+    graph.compact();
+    graph.reachability();
+    if (options.algorithm == "arcflags") {
+        graph.arcFlags();
+    }
+    if (options.algorithm == "crp") {
+        graph.customizedRoutes();
+    }
+
+    ThreadPool pool(options.threads == 0 ? thread::hardware_concurrency() : options.threads);
+    size_t chunkSize = pool.size() * QUERIES_PER_THREAD;
+
+    // Read, answer and write one bounded chunk at a time, preserving input order
+    vector<string> lines;
+    vector<string> results;
+    lines.reserve(chunkSize);
+    string line;
+    bool moreInput = true;
+
+    while (moreInput) {
+        lines.clear();
+        while (lines.size() < chunkSize && (moreInput = static_cast<bool>(getline(queries, line)))) {
+            if (!line.empty() && line.back() == '\r') {
+                line.pop_back();
+            }
+            if (line.empty() || line[0] == '#') {
+                continue;
+            }
+            lines.push_back(line);
+        }
+
+        results.assign(lines.size(), string());
+        pool.parallelFor(lines.size(), [&](size_t i, unsigned) {
+            results[i] = answerQuery(graph, lines[i], options.algorithm);
+        }, 16);
+
+        for (const auto& result : results) {
+            out << result << '\n';
+        }
+    }
+
+    out.flush();
+    return out ? 0 : 1;
+}
+
+int BatchRunner::runSsspBenchmark(const Graph& graph, const Options& options) {
+    int source = graph.cityId(options.benchSource);
+    if (source < 0) {
+        cerr << "City " << Graph::standardizeCity(options.benchSource) << " not found in the graph.\n";
+        return 1;
+    }
+
+    auto compact = graph.compact();
+    int delta = options.delta > 0 ? options.delta : DeltaStepping::defaultDelta(*compact);
+    cout << "Delta-stepping from " << Graph::standardizeCity(options.benchSource) << ": "
+         << compact->liveCount << " cities, " << compact->edgeCount() << " edges, delta " << delta << "\n";
+
+    auto start = chrono::steady_clock::now();
+    vector<int> reference = Dijkstra::distancesFrom(*compact, source);
+    double dijkstraMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+    cout << fixed << setprecision(2);
+    cout << "Dijkstra (1 thread): " << dijkstraMs << " ms\n";
+
+    bool allMatch = true;
+    double baseMs = 0;
+    for (unsigned threads : {1u, 2u, 4u, 8u, 16u}) {
+        ThreadPool pool(threads);
+        start = chrono::steady_clock::now();
+        vector<int> distances = DeltaStepping::distances(*compact, source, pool, delta);
+        double elapsedMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+        if (threads == 1) {
+            baseMs = elapsedMs;
+        }
+
+        bool matches = distances == reference;
+        allMatch = allMatch && matches;
+        cout << setw(2) << threads << " threads: " << setw(10) << elapsedMs << " ms, speedup "
+             << (elapsedMs > 0 ? baseMs / elapsedMs : 0.0) << "x, "
+             << (matches ? "matches Dijkstra" : "MISMATCH") << "\n";
+    }
+
+    return allMatch ? 0 : 1;
+}
+
+int BatchRunner::runCrpBenchmark(Graph& graph, const Options& options) {
+    auto compact = graph.compact();
+    cout << "Customizable route planning: " << compact->liveCount << " cities, "
+         << compact->edgeCount() << " edges\n" << fixed << setprecision(2);
+
+    // Metric-independent preprocessing, done once per topology
+    auto start = chrono::steady_clock::now();
+    auto partition = make_shared<const MultiLevelPartition>(MultiLevelPartition::build(*compact));
+    double elapsedMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+    cout << "Partition: " << elapsedMs << " ms, " << partition->levelCount() << " levels";
+    for (int level = 0; level < partition->levelCount(); ++level) {
+        cout << (level == 0 ? " (" : ", ") << partition->cellCount(level) << " cells of <= "
+             << partition->maxCellSize(level);
+    }
+    cout << (partition->levelCount() > 0 ? ")\n" : "\n");
+
+    // Metric customization, the part that reruns after every distance change
+    for (unsigned threads : {1u, 2u, 4u, 8u, 16u}) {
+        ThreadPool pool(threads);
+        start = chrono::steady_clock::now();
+        CustomizedRoutes::customize(partition, *compact, pool);
+        elapsedMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+        cout << setw(2) << threads << " threads: customization " << setw(10) << elapsedMs << " ms\n";
+    }
+
+    // Random queries against plain Dijkstra, before and after a traffic update
+    mt19937 random(42);
+    vector<int> liveCities;
+    for (int u = 0; u < compact->nodeCount(); ++u) {
+        if (compact->isAlive(u)) liveCities.push_back(u);
+    }
+    if (liveCities.empty()) {
+        return 0;
+    }
+
+    bool allMatch = true;
+    for (int round = 0; round < 2; ++round) {
+        if (round == 1) {
+            // Change 1% of the distances by up to +-50%, keeping every edge
+            streambuf* stdoutBuffer = cout.rdbuf(nullptr);
+            vector<tuple<string, string, int>> updates;
+            for (const auto& [city, neighbors] : graph.getAdjList()) {
+                for (const auto& [neighbor, distance] : neighbors) {
+                    if (random() % 100 == 0) {
+                        int factor = 50 + static_cast<int>(random() % 101);
+                        updates.emplace_back(city, neighbor, max(1, distance * factor / 100));
+                    }
+                }
+            }
+            for (const auto& [from, to, distance] : updates) {
+                graph.updateEdge(from, to, distance);
+            }
+            cout.rdbuf(stdoutBuffer);
+            cout.clear();
+
+            start = chrono::steady_clock::now();
+            compact = graph.compact();
+            graph.customizedRoutes();   // Partition reused, only customization runs
+            elapsedMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+            cout << "Traffic update: " << updates.size() << " distances changed, re-customized in "
+                 << elapsedMs << " ms\n";
+        } else {
+            graph.customizedRoutes();
+        }
+
+        auto routes = graph.customizedRoutes();
+        double crpMs = 0;
+        double dijkstraMs = 0;
+        size_t crpSettled = 0;
+        size_t dijkstraSettled = 0;
+        int mismatches = 0;
+        for (int q = 0; q < options.crpQueries; ++q) {
+            int source = liveCities[random() % liveCities.size()];
+            int target = liveCities[random() % liveCities.size()];
+
+            vector<int> nodes;
+            size_t settled = 0;
+            start = chrono::steady_clock::now();
+            int distance = routes->shortestPath(*compact, source, target, nodes, &settled);
+            crpMs += chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+            crpSettled += settled;
+
+            // Uncached Dijkstra on the same snapshot, so neither side gets the path cache
+            // or the reachability pre-check
+            start = chrono::steady_clock::now();
+            PathResult reference = PathEngine::dijkstra(*compact, source, target);
+            dijkstraMs += chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+            dijkstraSettled += reference.settled;
+            if (reference.distance != distance) {
+                mismatches++;
+            }
+        }
+        allMatch = allMatch && mismatches == 0;
+        cout << (round == 0 ? "Queries: " : "Queries after update: ")
+             << crpMs / options.crpQueries << " ms avg (" << crpSettled / options.crpQueries
+             << " settled), Dijkstra " << dijkstraMs / options.crpQueries << " ms avg ("
+             << dijkstraSettled / options.crpQueries << " settled), "
+             << (mismatches == 0 ? "all match" : to_string(mismatches) + " MISMATCHES") << "\n";
+    }
+
+    return allMatch ? 0 : 1;
+}
+
+// The traversals as they were before the id kernels: names copied onto the
+// frontier and a hash set of visited names. Kept as the benchmark baseline.
+static vector<string> namedDfs(const Graph& graph, const string& startCity) {
+    const auto& adjList = graph.getAdjList();
+    vector<string> order;
+    unordered_set<string> visited;
+    stack<string> s;
+    s.push(startCity);
+    while (!s.empty()) {
+        string current = s.top();
+        s.pop();
+        if (visited.insert(current).second) {
+            order.push_back(current);
+            for (auto it = adjList.at(current).rbegin(); it != adjList.at(current).rend(); ++it) {
+                if (visited.find(it->first) == visited.end()) {
+                    s.push(it->first);
+                }
+            }
+        }
+    }
+    return order;
+}
+
+static vector<string> namedBfs(const Graph& graph, const string& startCity) {
+    const auto& adjList = graph.getAdjList();
+    vector<string> order;
+    unordered_set<string> visited;
+    queue<string> q;
+    q.push(startCity);
+    visited.insert(startCity);
+    while (!q.empty()) {
+        string current = q.front();
+        q.pop();
+        order.push_back(current);
+        for (const auto& [neighbor, _] : adjList.at(current)) {
+            if (visited.insert(neighbor).second) {
+                q.push(neighbor);
+            }
+        }
+    }
+    return order;
+}
+
+int BatchRunner::runTraversalBenchmark(const Graph& graph, const Options& options) {
+    string startCity = Graph::standardizeCity(options.traversalSource);
+    int source = graph.cityId(startCity);
+    if (source < 0) {
+        cerr << "City " << startCity << " not found in the graph.\n";
+        return 1;
+    }
+
+    auto compact = graph.compact();
+    cout << "Traversal from " << startCity << ": " << compact->liveCount << " cities, "
+         << compact->edgeCount() << " edges\n";
+
+    bool allMatch = true;
+    for (const string kind : {"DFS", "BFS"}) {
+        auto start = chrono::steady_clock::now();
+        vector<string> named = kind == "DFS" ? namedDfs(graph, startCity) : namedBfs(graph, startCity);
+        double namedMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+        start = chrono::steady_clock::now();
+        vector<int> order = kind == "DFS" ? Traversal::dfsOrder(*compact, source)
+                                          : Traversal::bfsOrder(*compact, source);
+        double idMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+        bool match = named.size() == order.size();
+        for (size_t i = 0; match && i < order.size(); ++i) {
+            match = named[i] == graph.cityName(order[i]);
+        }
+        allMatch = allMatch && match;
+        cout << kind << ": " << order.size() << " visited, names " << setw(10) << namedMs << " ms, ids "
+             << setw(10) << idMs << " ms (" << (idMs > 0 ? namedMs / idMs : 0) << "x), "
+             << (match ? "same order" : "ORDER MISMATCH") << "\n";
+    }
+
+    // Level-synchronous parallel BFS, checked against the serial visit order and levels
+    vector<int> serial = Traversal::bfsOrder(*compact, source);
+    HopTree hops = Traversal::hopDistances(*compact, source);
+    for (unsigned threads : {1u, 2u, 4u, 8u, 16u}) {
+        ThreadPool pool(threads);
+        cout << setw(2) << threads << " threads:";
+        for (bool deterministic : {false, true}) {
+            auto start = chrono::steady_clock::now();
+            LevelOrder levels = Traversal::parallelBfs(*compact, source, pool, deterministic);
+            double elapsedMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+            bool match = levels.level == hops.hops && levels.order.size() == serial.size() &&
+                         (!deterministic || levels.order == serial);
+            allMatch = allMatch && match;
+            cout << (deterministic ? "  deterministic " : " parallel BFS ") << setw(10) << elapsedMs << " ms"
+                 << (match ? "" : " MISMATCH");
+        }
+        cout << "\n";
+    }
+
+    // One MS-BFS batch against the same BFS runs one source at a time. The
+    // one-at-a-time baselines only run a few sources and are scaled per source.
+    vector<int> sources{source};
+    int stride = max(1, compact->nodeCount() / MultiSourceBfs::BATCH);
+    for (int city = 0; city < compact->nodeCount() && static_cast<int>(sources.size()) < MultiSourceBfs::BATCH;
+         city += stride) {
+        if (compact->isAlive(city) && city != source) sources.push_back(city);
+    }
+    auto start = chrono::steady_clock::now();
+    vector<vector<int>> histogram = MultiSourceBfs::hopHistogram(*compact, sources, ThreadPool::shared());
+    double batchMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+    double perSourceMs = batchMs / sources.size();
+
+    size_t baselineCount = min<size_t>(MSBFS_BASELINE_SOURCES, sources.size());
+    start = chrono::steady_clock::now();
+    for (size_t i = 0; i < baselineCount; ++i) {
+        HopTree tree = Traversal::hopDistances(*compact, sources[i]);
+        vector<int> counts;
+        for (int h : tree.hops) {
+            if (h < 0) continue;
+            if (static_cast<int>(counts.size()) <= h) counts.resize(h + 1, 0);
+            counts[h]++;
+        }
+        allMatch = allMatch && counts == histogram[i];
+    }
+    double hopMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count() / baselineCount;
+
+    start = chrono::steady_clock::now();
+    for (size_t i = 0; i < baselineCount; ++i) {
+        vector<string> path;
+        Traversal::bfsWithPath(graph, graph.cityName(sources[i]), path);
+    }
+    double namedMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count() / baselineCount;
+
+    cout << "MS-BFS, " << sources.size() << " sources: " << setw(10) << batchMs << " ms ("
+         << perSourceMs << " ms per source); one at a time: hopDistances " << hopMs << " ms ("
+         << (perSourceMs > 0 ? hopMs / perSourceMs : 0) << "x), bfsWithPath " << namedMs << " ms ("
+         << (perSourceMs > 0 ? namedMs / perSourceMs : 0) << "x)\n";
+    return allMatch ? 0 : 1;
+}
+
+// Plain Dinic (BFS levels, then blocking flows by DFS), the reference for the flow benchmark
+static long long dinicFlow(const CompactGraph& graph, int source, int sink) {
+    int n = graph.nodeCount();
+    vector<int> first(n + 1, 0);
+    for (int u = 0; u < n; ++u) {
+        first[u + 1] = first[u] + graph.outDegree(u) + graph.inDegree(u);
+    }
+    vector<int> head(first[n]), mate(first[n]), residual(first[n], 0);
+    vector<int> fill(first.begin(), first.end() - 1);
+    for (int u = 0; u < n; ++u) {
+        for (int e = graph.offsets[u]; e < graph.offsets[u + 1]; ++e) {
+            int a = fill[u]++;
+            int b = fill[graph.targets[e]]++;
+            head[a] = graph.targets[e];
+            head[b] = u;
+            mate[a] = b;
+            mate[b] = a;
+            residual[a] = graph.weights[e];
+        }
+    }
+
+    long long flow = 0;
+    vector<int> level(n), next(n), queue;
+    while (true) {
+        std::fill(level.begin(), level.end(), -1);
+        queue.assign(1, source);
+        level[source] = 0;
+        for (size_t i = 0; i < queue.size(); ++i) {
+            for (int a = first[queue[i]]; a < first[queue[i] + 1]; ++a) {
+                if (residual[a] > 0 && level[head[a]] < 0) {
+                    level[head[a]] = level[queue[i]] + 1;
+                    queue.push_back(head[a]);
+                }
+            }
+        }
+        if (level[sink] < 0) {
+            return flow;
+        }
+
+        // Iterative DFS along level-increasing arcs, one augmenting path at a time
+        copy(first.begin(), first.end() - 1, next.begin());
+        vector<int> path;
+        int u = source;
+        while (true) {
+            if (u == sink) {
+                int delta = INT_MAX;
+                for (int a : path) delta = min(delta, residual[a]);
+                for (int a : path) {
+                    residual[a] -= delta;
+                    residual[mate[a]] += delta;
+                }
+                flow += delta;
+                path.clear();
+                u = source;
+                continue;
+            }
+            int& a = next[u];
+            while (a < first[u + 1] && (residual[a] == 0 || level[head[a]] != level[u] + 1)) {
+                ++a;
+            }
+            if (a < first[u + 1]) {
+                path.push_back(a);
+                u = head[a];
+            } else if (u == source) {
+                break;
+            } else {
+                // Dead end: retreat and skip the arc that led here
+                level[u] = -1;
+                u = head[mate[path.back()]];
+                path.pop_back();
+            }
+        }
+    }
+}
+
+// Synthetic networks: a SIZE x SIZE grid of two-way streets with random capacities,
+// and a road-like variant where a fifth of the streets are missing and every
+// tenth row and column is a high-capacity arterial with occasional diagonal links
+static void buildFlowNetwork(Graph& graph, int size, bool roadLike, mt19937& random) {
+    streambuf* stdoutBuffer = cout.rdbuf(nullptr);
+    auto name = [](int row, int column) { return "N" + to_string(row) + "_" + to_string(column); };
+    for (int row = 0; row < size; ++row) {
+        for (int column = 0; column < size; ++column) {
+            graph.addCity(name(row, column));
+        }
+    }
+    auto road = [&](int row, int column, int toRow, int toColumn, int capacity) {
+        graph.addEdge(name(row, column), name(toRow, toColumn), capacity);
+        graph.addEdge(name(toRow, toColumn), name(row, column), capacity);
+    };
+    for (int row = 0; row < size; ++row) {
+        for (int column = 0; column < size; ++column) {
+            for (int direction = 0; direction < 2; ++direction) {
+                int toRow = row + direction;
+                int toColumn = column + 1 - direction;
+                if (toRow >= size || toColumn >= size) continue;
+                if (!roadLike) {
+                    road(row, column, toRow, toColumn, 1 + static_cast<int>(random() % 100));
+                    continue;
+                }
+                bool arterial = direction == 0 ? row % 10 == 0 : column % 10 == 0;
+                if (arterial) {
+                    road(row, column, toRow, toColumn, 200 + static_cast<int>(random() % 201));
+                } else if (random() % 5 != 0) {
+                    road(row, column, toRow, toColumn, 10 + static_cast<int>(random() % 31));
+                }
+            }
+            if (roadLike && row + 1 < size && column + 1 < size && random() % 20 == 0) {
+                road(row, column, row + 1, column + 1, 10 + static_cast<int>(random() % 31));
+            }
+        }
+    }
+
+    // Super source and sink behind the west and east edges
+    graph.addCity("SOURCE");
+    graph.addCity("SINK");
+    int unlimited = 1000 * size;
+    for (int row = 0; row < size; ++row) {
+        graph.addEdge("SOURCE", name(row, 0), unlimited);
+        graph.addEdge(name(row, size - 1), "SINK", unlimited);
+    }
+    cout.rdbuf(stdoutBuffer);
+    cout.clear();
+}
+
+int BatchRunner::runFlowBenchmark(const Options& options) {
+    mt19937 random(42);
+    bool allMatch = true;
+    cout << fixed << setprecision(2);
+    for (bool roadLike : {false, true}) {
+        Graph graph;
+        buildFlowNetwork(graph, options.flowSize, roadLike, random);
+        auto compact = graph.compact();
+        int source = graph.cityId("SOURCE");
+        int sink = graph.cityId("SINK");
+
+        auto start = chrono::steady_clock::now();
+        FlowResult result = MaxFlow::compute(*compact, source, sink);
+        double pushRelabelMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+        start = chrono::steady_clock::now();
+        long long reference = dinicFlow(*compact, source, sink);
+        double dinicMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+        long long cutCapacity = 0;
+        for (const auto& edge : result.cut) {
+            cutCapacity += edge.capacity;
+        }
+        bool match = result.value == reference && cutCapacity == reference;
+        allMatch = allMatch && match;
+
+        cout << (roadLike ? "Road-like " : "Grid ") << options.flowSize << "x" << options.flowSize << ": "
+             << compact->liveCount << " cities, " << compact->edgeCount() << " edges\n";
+        cout << "  Push-relabel: " << setw(10) << pushRelabelMs << " ms, flow " << result.value << ", cut of "
+             << result.cut.size() << " roads (" << result.pushes << " pushes, " << result.relabels
+             << " relabels, " << result.globalRelabels << " global relabels, " << result.gaps << " gaps)\n";
+        cout << "  Dinic:        " << setw(10) << dinicMs << " ms ("
+             << (pushRelabelMs > 0 ? dinicMs / pushRelabelMs : 0) << "x), "
+             << (match ? "same flow and cut capacity" : "MISMATCH") << "\n";
+    }
+    return allMatch ? 0 : 1;
+}
+
+int BatchRunner::runCentralityCheck() {
+    // S reaches X directly and through Y over a zero-length road, then X goes on to T.
+    // Y and X tie at distance 1, so Y must be ordered before X when the paths are
+    // counted: X carries every path to T (2) and Y half of the paths to X and T (1).
+    // The cities are declared in both orders so the zero road runs both ways in id order.
+    struct Case {
+        vector<string> cities;
+        map<string, double> expected;
+    };
+    vector<Case> cases = {
+        {{"S", "X", "Y", "T"}, {{"S", 0}, {"X", 2}, {"Y", 1}, {"T", 0}}},
+        {{"S", "Y", "X", "T"}, {{"S", 0}, {"X", 2}, {"Y", 1}, {"T", 0}}},
+    };
+
+    bool allMatch = true;
+    for (const auto& check : cases) {
+        Graph graph;
+        streambuf* stdoutBuffer = cout.rdbuf(nullptr);
+        for (const auto& city : check.cities) {
+            graph.addCity(city);
+        }
+        graph.addEdge("S", "X", 1);
+        graph.addEdge("S", "Y", 1);
+        graph.addEdge("Y", "X", 0);
+        graph.addEdge("X", "T", 1);
+        cout.rdbuf(stdoutBuffer);
+        cout.clear();
+
+        CentralityScores scores = Centrality::compute(*graph.compact(), true, ThreadPool::shared());
+        cout << "Cities in id order";
+        for (const auto& city : check.cities) {
+            cout << " " << city;
+        }
+        cout << ":";
+        for (const auto& city : check.cities) {
+            double actual = scores.betweenness[graph.cityId(city)];
+            double expected = check.expected.at(city);
+            bool match = abs(actual - expected) < 1e-9;
+            allMatch = allMatch && match;
+            cout << " " << city << "=" << actual;
+            if (!match) {
+                cout << " (expected " << expected << ")";
+            }
+        }
+        cout << "\n";
+    }
+    cout << (allMatch ? "Centrality check passed\n" : "Centrality check FAILED\n");
+    return allMatch ? 0 : 1;
+}
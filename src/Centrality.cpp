@@ -0,0 +1,286 @@
+#include "../include/Centrality.hpp"
+#include <iostream>
+#include <iomanip>
+#include <memory>
+#include <random>
+#include <algorithm>
+#include <functional>
+#include <limits>
+
+using namespace std;
+
+namespace {
+
+// One worker's search state plus its share of the sums
+struct BrandesWorker {
+    explicit BrandesWorker(int n)
+        : dist(n, -1), sigma(n, 0.0), delta(n, 0.0), pending(n, 0),
+          betweenness(n, 0.0), distanceSum(n, 0.0), reachedBy(n, 0) {}
+
+    vector<int> dist;       // -1 until reached
+    vector<double> sigma;   // Number of shortest paths from the source
+    vector<double> delta;   // Dependency of the source on the city
+    vector<int> order;      // Cities in non-decreasing distance, predecessors first
+    vector<pair<int, int>> heap;
+    vector<int> pending;    // Zero-length tight roads into a city not yet ordered
+    vector<int> ready;
+
+    vector<double> betweenness;
+    vector<double> distanceSum;
+    vector<int> reachedBy;
+};
+
+// Cities at the same distance can be joined by zero-length roads. Within each
+// such group, put the two ends of every such road in order (Kahn's algorithm), so that
+// path counts can be summed front to back and dependencies back to front.
+// Cities on a zero-length cycle have infinitely many shortest walks; they
+// keep their settle order.
+void orderTies(const CompactGraph& graph, int source, BrandesWorker& w) {
+    size_t begin = 0;
+    while (begin < w.order.size()) {
+        int d = w.dist[w.order[begin]];
+        size_t end = begin;
+        bool tied = false;
+        for (; end < w.order.size() && w.dist[w.order[end]] == d; ++end) {
+            int city = w.order[end];
+            if (city == source) continue;
+            for (int slot = graph.inOffsets[city]; slot < graph.inOffsets[city + 1]; ++slot) {
+                int from = graph.sources[slot];
+                if (graph.weights[graph.inEdges[slot]] == 0 && from != city && w.dist[from] == d) {
+                    w.pending[city]++;
+                    tied = true;
+                }
+            }
+        }
+
+        if (tied) {
+            w.ready.clear();
+            for (size_t i = begin; i < end; ++i) {
+                if (w.pending[w.order[i]] == 0) w.ready.push_back(w.order[i]);
+            }
+            for (size_t i = 0; i < w.ready.size(); ++i) {
+                int city = w.ready[i];
+                for (int e = graph.offsets[city]; e < graph.offsets[city + 1]; ++e) {
+                    int v = graph.targets[e];
+                    if (graph.weights[e] == 0 && v != city && v != source && w.dist[v] == d &&
+                        --w.pending[v] == 0) {
+                        w.ready.push_back(v);
+                    }
+                }
+            }
+            for (size_t i = begin; i < end; ++i) {
+                if (w.pending[w.order[i]] > 0) {
+                    w.pending[w.order[i]] = 0;
+                    w.ready.push_back(w.order[i]);
+                }
+            }
+            copy(w.ready.begin(), w.ready.end(), w.order.begin() + begin);
+        }
+        begin = end;
+    }
+}
+
+void search(const CompactGraph& graph, int source, bool weighted, BrandesWorker& w) {
+    w.order.clear();
+    w.dist[source] = 0;
+    w.sigma[source] = 1.0;
+
+    if (!weighted) {
+        // Plain BFS; order doubles as the queue
+        w.order.push_back(source);
+        for (size_t head = 0; head < w.order.size(); ++head) {
+            int u = w.order[head];
+            for (int e = graph.offsets[u]; e < graph.offsets[u + 1]; ++e) {
+                int v = graph.targets[e];
+                if (w.dist[v] < 0) {
+                    w.dist[v] = w.dist[u] + 1;
+                    w.order.push_back(v);
+                }
+                if (w.dist[v] == w.dist[u] + 1) {
+                    w.sigma[v] += w.sigma[u];
+                }
+            }
+        }
+        return;
+    }
+
+    // Dijkstra for the distances only. A zero-length road can join two cities
+    // at the same distance in either settle order, so path counts wait until
+    // the ties have been ordered.
+    w.heap.clear();
+    w.heap.push_back({0, source});
+    while (!w.heap.empty()) {
+        pop_heap(w.heap.begin(), w.heap.end(), greater<pair<int, int>>());
+        auto [d, u] = w.heap.back();
+        w.heap.pop_back();
+        if (d > w.dist[u]) continue;
+        w.order.push_back(u);
+        for (int e = graph.offsets[u]; e < graph.offsets[u + 1]; ++e) {
+            int v = graph.targets[e];
+            int nd = d + graph.weights[e];
+            if (w.dist[v] < 0 || nd < w.dist[v]) {
+                w.dist[v] = nd;
+                w.heap.push_back({nd, v});
+                push_heap(w.heap.begin(), w.heap.end(), greater<pair<int, int>>());
+            }
+        }
+    }
+
+    orderTies(graph, source, w);
+    for (int city : w.order) {
+        if (city == source) continue;
+        for (int slot = graph.inOffsets[city]; slot < graph.inOffsets[city + 1]; ++slot) {
+            int from = graph.sources[slot];
+            if (w.dist[from] >= 0 && from != city &&
+                w.dist[from] + graph.weights[graph.inEdges[slot]] == w.dist[city]) {
+                w.sigma[city] += w.sigma[from];
+            }
+        }
+    }
+}
+
+void accumulate(const CompactGraph& graph, int source, bool weighted, BrandesWorker& w) {
+    for (auto it = w.order.rbegin(); it != w.order.rend(); ++it) {
+        int city = *it;
+        // Predecessors are the in-neighbours one tight edge closer to the source
+        for (int slot = graph.inOffsets[city]; slot < graph.inOffsets[city + 1]; ++slot) {
+            int from = graph.sources[slot];
+            int length = weighted ? graph.weights[graph.inEdges[slot]] : 1;
+            if (w.dist[from] >= 0 && w.dist[from] + length == w.dist[city] && from != city) {
+                w.delta[from] += w.sigma[from] / w.sigma[city] * (1.0 + w.delta[city]);
+            }
+        }
+        if (city != source) {
+            w.betweenness[city] += w.delta[city];
+            w.distanceSum[city] += w.dist[city];
+            w.reachedBy[city]++;
+        }
+    }
+    for (int city : w.order) {
+        w.dist[city] = -1;
+        w.sigma[city] = 0.0;
+        w.delta[city] = 0.0;
+    }
+}
+
+}  // namespace
+
+CentralityScores Centrality::compute(const CompactGraph& graph, bool weighted, ThreadPool& pool,
+                                     int samples, unsigned seed) {
+    int n = graph.nodeCount();
+    CentralityScores scores;
+    scores.weighted = weighted;
+    scores.betweenness.assign(n, 0.0);
+    scores.closeness.assign(n, 0.0);
+
+    vector<int> sources;
+    for (int u = 0; u < n; ++u) {
+        if (graph.isAlive(u)) sources.push_back(u);
+    }
+    int live = static_cast<int>(sources.size());
+    if (samples > 0 && samples < live) {
+        shuffle(sources.begin(), sources.end(), mt19937(seed));
+        sources.resize(samples);
+    }
+    scores.sources = static_cast<int>(sources.size());
+    if (live < 2) {
+        return scores;
+    }
+
+    // Workers allocate their arrays on first use, so idle ones cost nothing
+    vector<unique_ptr<BrandesWorker>> workers(pool.size());
+    pool.parallelFor(sources.size(), [&](size_t i, unsigned worker) {
+        if (!workers[worker]) {
+            workers[worker] = make_unique<BrandesWorker>(n);
+        }
+        BrandesWorker& w = *workers[worker];
+        search(graph, sources[i], weighted, w);
+        accumulate(graph, sources[i], weighted, w);
+    });
+
+    double scale = static_cast<double>(live) / scores.sources;
+    pool.parallelFor(n, [&](size_t city, unsigned) {
+        double betweenness = 0.0, distanceSum = 0.0, reachedBy = 0.0;
+        for (const auto& w : workers) {
+            if (!w) continue;
+            betweenness += w->betweenness[city];
+            distanceSum += w->distanceSum[city];
+            reachedBy += w->reachedBy[city];
+        }
+        scores.betweenness[city] = betweenness * scale;
+        // Scaled by the share of other cities that reach it at all
+        double reached = min(reachedBy * scale, static_cast<double>(live - 1));
+        if (distanceSum > 0) {
+            scores.closeness[city] = (reached / (live - 1)) * (reachedBy / distanceSum);
+        }
+    }, 4096);
+    return scores;
+}
+
+void Centrality::showRanking(Graph& graph) {
+    auto compact = graph.compact();
+    int cities = compact->liveCount;
+    if (cities < 2) {
+        cout << "Centrality needs at least two cities.\n";
+        return;
+    }
+
+    string answer;
+    cout << "Use road distances rather than hop counts? (y/n, or type 'back' to return to main menu): ";
+    cin >> answer;
+    if (answer == "back" || answer == "BACK" || answer == "Back") {
+        return;
+    }
+    bool weighted = answer == "y" || answer == "Y" || answer == "yes";
+
+    int samples = 0;
+    if (cities > EXACT_LIMIT) {
+        cout << "Sources to sample (0 = all " << cities << " cities, exact): ";
+        if (!(cin >> samples) || samples < 0) {
+            cin.clear();
+            cin.ignore(numeric_limits<streamsize>::max(), '\n');
+            cout << "Invalid input.\n";
+            return;
+        }
+    }
+
+    int listed = 0;
+    cout << "How many cities to list: ";
+    if (!(cin >> listed) || listed <= 0) {
+        cin.clear();
+        cin.ignore(numeric_limits<streamsize>::max(), '\n');
+        cout << "Invalid input.\n";
+        return;
+    }
+
+    CentralityScores scores = compute(*compact, weighted, ThreadPool::shared(), samples);
+
+    vector<int> ranked;
+    for (int city = 0; city < compact->nodeCount(); ++city) {
+        if (compact->isAlive(city)) ranked.push_back(city);
+    }
+    sort(ranked.begin(), ranked.end(), [&](int a, int b) {
+        if (scores.betweenness[a] != scores.betweenness[b]) {
+            return scores.betweenness[a] > scores.betweenness[b];
+        }
+        return scores.closeness[a] > scores.closeness[b];
+    });
+    if (static_cast<int>(ranked.size()) > listed) {
+        ranked.resize(listed);
+    }
+
+    cout << "\nTransit hubs by " << (weighted ? "distance" : "hop") << " betweenness";
+    if (scores.sources < cities) {
+        cout << " (estimated from " << scores.sources << " of " << cities << " cities)";
+    }
+    cout << ":\n";
+    cout << left << setw(6) << "Rank" << setw(20) << "City" << right
+         << setw(16) << "Betweenness" << setw(12) << "Closeness" << "\n";
+    for (size_t i = 0; i < ranked.size(); ++i) {
+        cout << left << setw(6) << i + 1 << setw(20) << graph.cityName(ranked[i]) << right << fixed
+             << setw(16) << setprecision(1) << scores.betweenness[ranked[i]]
+             << setw(12) << setprecision(4) << scores.closeness[ranked[i]] << "\n";
+    }
+    cout.unsetf(ios::fixed);
+    cout << setprecision(6);
+}
@@ -0,0 +1,52 @@
+#include "../include/CompactGraph.hpp"
+#include "../include/Graph.hpp"
+
+using namespace std;
+
+CompactGraph CompactGraph::build(const Graph& graph) {
+    CompactGraph compact;
+    int n = static_cast<int>(graph.cityNames.size());
+
+    compact.alive.assign(n, 0);
+    compact.offsets.assign(n + 1, 0);
+    compact.inOffsets.assign(n + 1, 0);
+
+    // Outgoing CSR, in city id order and adjacency order
+    for (int u = 0; u < n; ++u) {
+        compact.offsets[u] = static_cast<int>(compact.targets.size());
+        const string& name = graph.cityNames[u];
+        if (name.empty()) {
+            continue;  // Deleted city
+        }
+        compact.alive[u] = 1;
+        compact.liveCount++;
+
+        for (const auto& [neighbor, dist] : graph.adjList.at(name)) {
+            int v = graph.cityIds.at(neighbor);
+            compact.targets.push_back(v);
+            compact.weights.push_back(dist);
+            compact.inOffsets[v + 1]++;
+            compact.maxWeight = max(compact.maxWeight, dist);
+            compact.totalWeight += dist;
+        }
+    }
+    compact.offsets[n] = static_cast<int>(compact.targets.size());
+
+    // Incoming CSR by counting sort on the target
+    for (int v = 0; v < n; ++v) {
+        compact.inOffsets[v + 1] += compact.inOffsets[v];
+    }
+    int m = compact.edgeCount();
+    compact.sources.resize(m);
+    compact.inEdges.resize(m);
+    vector<int> fill(compact.inOffsets.begin(), compact.inOffsets.end() - 1);
+    for (int u = 0; u < n; ++u) {
+        for (int e = compact.offsets[u]; e < compact.offsets[u + 1]; ++e) {
+            int slot = fill[compact.targets[e]]++;
+            compact.sources[slot] = u;
+            compact.inEdges[slot] = e;
+        }
+    }
+
+    return compact;
+}
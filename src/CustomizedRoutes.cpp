@@ -0,0 +1,224 @@
+#include "../include/CustomizedRoutes.hpp"
+#include "../include/SearchWorkspace.hpp"
+#include <climits>
+#include <algorithm>
+
+using namespace std;
+
+CustomizedRoutes CustomizedRoutes::customize(shared_ptr<const MultiLevelPartition> partition,
+                                             const CompactGraph& graph, ThreadPool& pool) {
+    CustomizedRoutes routes;
+    routes.cells = move(partition);
+    const MultiLevelPartition& p = *routes.cells;
+    routes.weights.resize(p.levelCount());
+
+    // Bottom-up: each level only reads the cliques of the level below
+    for (int level = 0; level < p.levelCount(); ++level) {
+        routes.weights[level].assign(p.cliqueSize(level), INT_MAX);
+        pool.parallelFor(p.cellCount(level), [&](size_t cell, unsigned) {
+            routes.customizeCell(graph, level, static_cast<int>(cell));
+        });
+    }
+    return routes;
+}
+
+void CustomizedRoutes::customizeCell(const CompactGraph& graph, int level, int cell) {
+    const MultiLevelPartition& p = *cells;
+    const vector<int>& entries = p.entries(level, cell);
+    const vector<int>& exits = p.exits(level, cell);
+    if (entries.empty() || exits.empty()) {
+        return;
+    }
+
+    SearchWorkspace& ws = SearchWorkspace::local();
+    size_t offset = p.cliqueOffset(level, cell);
+    for (size_t i = 0; i < entries.size(); ++i) {
+        ws.begin(graph.nodeCount());
+        ws.set(entries[i], 0, -1);
+        ws.push(0, entries[i]);
+
+        while (!ws.empty()) {
+            auto [d, u] = ws.pop();
+            if (d > ws.distance(u)) continue;
+            auto relax = [&](int v, int weight) {
+                if (weight == INT_MAX) return;
+                int nd = d + weight;
+                if (nd < ws.distance(v)) {
+                    ws.set(v, nd, u);
+                    ws.push(nd, v);
+                }
+            };
+
+            if (level == 0) {
+                // Original edges that stay inside the cell
+                for (int e = graph.offsets[u]; e < graph.offsets[u + 1]; ++e) {
+                    if (p.cellOf(0, graph.targets[e]) == cell) relax(graph.targets[e], graph.weights[e]);
+                }
+                continue;
+            }
+
+            // Overlay of the level below: subcell cliques plus edges between subcells
+            int sub = p.cellOf(level - 1, u);
+            int entry = p.entryIndex(level - 1, u);
+            if (entry >= 0) {
+                const vector<int>& subExits = p.exits(level - 1, sub);
+                for (size_t j = 0; j < subExits.size(); ++j) {
+                    relax(subExits[j], clique(level - 1, sub, entry, static_cast<int>(j)));
+                }
+            }
+            if (p.exitIndex(level - 1, u) >= 0) {
+                for (int e = graph.offsets[u]; e < graph.offsets[u + 1]; ++e) {
+                    int v = graph.targets[e];
+                    if (p.cellOf(level, v) == cell && p.cellOf(level - 1, v) != sub) {
+                        relax(v, graph.weights[e]);
+                    }
+                }
+            }
+        }
+
+        for (size_t j = 0; j < exits.size(); ++j) {
+            weights[level][offset + i * exits.size() + j] = ws.distance(exits[j]);
+        }
+    }
+}
+
+int CustomizedRoutes::shortestPath(const CompactGraph& graph, int source, int target, vector<int>& nodes,
+                                   size_t* settled) const {
+    nodes.clear();
+    int n = graph.nodeCount();
+    if (source < 0 || target < 0 || source >= n || target >= n ||
+        !graph.isAlive(source) || !graph.isAlive(target)) {
+        return -1;
+    }
+    if (source == target) {
+        nodes.push_back(source);
+        return 0;
+    }
+
+    const MultiLevelPartition& p = *cells;
+    // The largest cell around a city that holds neither endpoint; level -1 when there is none.
+    // Inside such a cell the search only moves along its clique.
+    auto queryCell = [&](int v) {
+        for (int level = p.levelCount() - 1; level >= 0; --level) {
+            int cell = p.cellOf(level, v);
+            if (cell != p.cellOf(level, source) && cell != p.cellOf(level, target)) {
+                return make_pair(level, cell);
+            }
+        }
+        return make_pair(-1, -1);
+    };
+
+    SearchWorkspace& forward = SearchWorkspace::local();
+    thread_local SearchWorkspace backward;
+    forward.begin(n);
+    backward.begin(n);
+    forward.set(source, 0, -1);
+    forward.push(0, source);
+    backward.set(target, 0, -1);
+    backward.push(0, target);
+
+    int best = INT_MAX;
+    int meeting = -1;
+    size_t settledCount = 0;
+
+    while (!forward.empty() || !backward.empty()) {
+        int forwardMin = forward.empty() ? INT_MAX : forward.top().first;
+        int backwardMin = backward.empty() ? INT_MAX : backward.top().first;
+        if (forwardMin == INT_MAX || backwardMin == INT_MAX || forwardMin + backwardMin >= best) {
+            break;
+        }
+
+        bool isForward = forwardMin <= backwardMin;
+        SearchWorkspace& ws = isForward ? forward : backward;
+        SearchWorkspace& other = isForward ? backward : forward;
+        auto [d, u] = ws.pop();
+        if (d > ws.distance(u)) continue;
+        settledCount++;
+
+        auto relax = [&](int v, int weight) {
+            if (weight == INT_MAX) return;
+            int nd = d + weight;
+            if (nd < ws.distance(v)) {
+                ws.set(v, nd, u);
+                ws.push(nd, v);
+                if (other.distance(v) != INT_MAX && nd + other.distance(v) < best) {
+                    best = nd + other.distance(v);
+                    meeting = v;
+                }
+            }
+        };
+
+        auto [level, cell] = queryCell(u);
+        if (isForward) {
+            if (level >= 0 && p.entryIndex(level, u) >= 0) {
+                const vector<int>& exits = p.exits(level, cell);
+                for (size_t j = 0; j < exits.size(); ++j) {
+                    relax(exits[j], clique(level, cell, p.entryIndex(level, u), static_cast<int>(j)));
+                }
+            }
+            for (int e = graph.offsets[u]; e < graph.offsets[u + 1]; ++e) {
+                if (level < 0 || p.cellOf(level, graph.targets[e]) != cell) relax(graph.targets[e], graph.weights[e]);
+            }
+        } else {
+            if (level >= 0 && p.exitIndex(level, u) >= 0) {
+                const vector<int>& entries = p.entries(level, cell);
+                for (size_t i = 0; i < entries.size(); ++i) {
+                    relax(entries[i], clique(level, cell, static_cast<int>(i), p.exitIndex(level, u)));
+                }
+            }
+            for (int e = graph.inOffsets[u]; e < graph.inOffsets[u + 1]; ++e) {
+                int v = graph.sources[e];
+                if (level < 0 || p.cellOf(level, v) != cell) relax(v, graph.weights[graph.inEdges[e]]);
+            }
+        }
+    }
+    if (settled) *settled = settledCount;
+    if (meeting < 0) {
+        return -1;
+    }
+
+    // Overlay path: source .. meeting from the forward tree, meeting .. target from the backward one
+    vector<int> overlay;
+    for (int v = meeting; v != -1; v = forward.parentOf(v)) overlay.push_back(v);
+    reverse(overlay.begin(), overlay.end());
+    for (int v = backward.parentOf(meeting); v != -1; v = backward.parentOf(v)) overlay.push_back(v);
+
+    // Two consecutive cities in the same query cell were joined by a clique; expand it
+    vector<pair<int, int>> overlayCells;
+    for (int v : overlay) overlayCells.push_back(queryCell(v));
+    nodes.push_back(overlay[0]);
+    for (size_t i = 1; i < overlay.size(); ++i) {
+        if (overlayCells[i].first >= 0 && overlayCells[i] == overlayCells[i - 1]) {
+            unpack(graph, overlayCells[i].first, overlayCells[i].second, overlay[i - 1], overlay[i], nodes);
+        } else {
+            nodes.push_back(overlay[i]);
+        }
+    }
+    return best;
+}
+
+void CustomizedRoutes::unpack(const CompactGraph& graph, int level, int cell, int from, int to,
+                              vector<int>& nodes) const {
+    // Cliques are shortest paths inside the cell, so a Dijkstra confined to it recovers one
+    SearchWorkspace& ws = SearchWorkspace::local();
+    ws.begin(graph.nodeCount());
+    ws.set(from, 0, -1);
+    ws.push(0, from);
+    while (!ws.empty()) {
+        auto [d, u] = ws.pop();
+        if (d > ws.distance(u)) continue;
+        if (u == to) break;
+        for (int e = graph.offsets[u]; e < graph.offsets[u + 1]; ++e) {
+            int v = graph.targets[e];
+            int nd = d + graph.weights[e];
+            if (cells->cellOf(level, v) == cell && nd < ws.distance(v)) {
+                ws.set(v, nd, u);
+                ws.push(nd, v);
+            }
+        }
+    }
+
+    size_t start = nodes.size();
+    for (int v = to; v != from; v = ws.parentOf(v)) nodes.push_back(v);
+    reverse(nodes.begin() + start, nodes.end());
+}
@@ -0,0 +1,140 @@
+#include "../include/DeltaStepping.hpp"
+#include <atomic>
+#include <algorithm>
+
+using namespace std;
+
+int DeltaStepping::defaultDelta(const CompactGraph& graph) {
+    if (graph.edgeCount() == 0) {
+        return 1;
+    }
+    return max(1, static_cast<int>(graph.totalWeight / graph.edgeCount()));
+}
+
+vector<int> DeltaStepping::distances(const CompactGraph& graph, int source,
+                                     ThreadPool& pool, int delta) {
+    int n = graph.nodeCount();
+    vector<int> result(n, UNREACHABLE);
+    if (source < 0 || source >= n || !graph.isAlive(source)) {
+        return result;
+    }
+    if (delta <= 0) {
+        delta = defaultDelta(graph);
+    }
+
+    // Reorder every adjacency range so light edges come first
+    vector<int> splitTargets(graph.edgeCount());
+    vector<int> splitWeights(graph.edgeCount());
+    vector<int> lightEnd(n);
+    pool.parallelFor(n, [&](size_t node, unsigned) {
+        int u = static_cast<int>(node);
+        int front = graph.offsets[u];
+        int back = graph.offsets[u + 1];
+        for (int e = graph.offsets[u]; e < graph.offsets[u + 1]; ++e) {
+            int slot = graph.weights[e] <= delta ? front++ : --back;
+            splitTargets[slot] = graph.targets[e];
+            splitWeights[slot] = graph.weights[e];
+        }
+        lightEnd[u] = front;
+    }, 1024);
+
+    vector<atomic<int>> dist(n);
+    for (auto& d : dist) {
+        d.store(UNREACHABLE, memory_order_relaxed);
+    }
+
+    // Every live tentative distance lies within maxWeight of the current
+    // bucket, so a ring of buckets is enough. Each worker owns its own ring.
+    size_t ringSize = static_cast<size_t>(graph.maxWeight / delta) + 2;
+    vector<vector<vector<int>>> buckets(pool.size(), vector<vector<int>>(ringSize));
+
+    auto relax = [&](int v, int candidate, unsigned worker) {
+        int current = dist[v].load(memory_order_relaxed);
+        while (candidate < current) {
+            if (dist[v].compare_exchange_weak(current, candidate, memory_order_relaxed)) {
+                buckets[worker][(candidate / delta) % ringSize].push_back(v);
+                return;
+            }
+        }
+    };
+
+    dist[source].store(0, memory_order_relaxed);
+    buckets[0][0].push_back(source);
+
+    vector<int> frontier;
+    vector<int> settled;
+    vector<int> relaxedAt(n, -1);  // Distance at which a node's light edges were last relaxed
+    vector<char> inSettled(n, 0);
+
+    // Drain the current bucket into frontier, dropping stale and repeated entries
+    auto gather = [&](int bucket) {
+        frontier.clear();
+        size_t slot = static_cast<size_t>(bucket) % ringSize;
+        for (auto& ring : buckets) {
+            for (int u : ring[slot]) {
+                int d = dist[u].load(memory_order_relaxed);
+                if (d / delta != bucket || relaxedAt[u] == d) {
+                    continue;
+                }
+                relaxedAt[u] = d;
+                frontier.push_back(u);
+                if (!inSettled[u]) {
+                    inSettled[u] = 1;
+                    settled.push_back(u);
+                }
+            }
+            ring[slot].clear();
+        }
+        return !frontier.empty();
+    };
+
+    int bucket = 0;
+    while (true) {
+        // Find the next non-empty bucket
+        bool found = false;
+        for (size_t step = 0; step < ringSize && !found; ++step) {
+            size_t slot = (static_cast<size_t>(bucket) + step) % ringSize;
+            for (const auto& ring : buckets) {
+                if (!ring[slot].empty()) {
+                    bucket += static_cast<int>(step);
+                    found = true;
+                    break;
+                }
+            }
+        }
+        if (!found) {
+            break;
+        }
+
+        // Light edges can refill the current bucket, so repeat until it stays empty
+        settled.clear();
+        while (gather(bucket)) {
+            pool.parallelFor(frontier.size(), [&](size_t i, unsigned worker) {
+                int u = frontier[i];
+                int du = dist[u].load(memory_order_relaxed);
+                for (int e = graph.offsets[u]; e < lightEnd[u]; ++e) {
+                    relax(splitTargets[e], du + splitWeights[e], worker);
+                }
+            }, 64);
+        }
+
+        // Nodes settled in this bucket are final; relax their heavy edges once
+        pool.parallelFor(settled.size(), [&](size_t i, unsigned worker) {
+            int u = settled[i];
+            int du = dist[u].load(memory_order_relaxed);
+            for (int e = lightEnd[u]; e < graph.offsets[u + 1]; ++e) {
+                relax(splitTargets[e], du + splitWeights[e], worker);
+            }
+        }, 64);
+
+        for (int u : settled) {
+            inSettled[u] = 0;
+        }
+        bucket++;
+    }
+
+    for (int u = 0; u < n; ++u) {
+        result[u] = dist[u].load(memory_order_relaxed);
+    }
+    return result;
+}
@@ -6,9 +6,8 @@
 using namespace std;
 
 
-void Dijkstra::dijkstra(Graph& graph, const string& startCity, const string& endCity) {
-    const auto& adjList = graph.getAdjList();
-    
+void Dijkstra::dijkstra(Graph& graph, const string& startCity, const string& endCity,
+                        PathAlgorithm algorithm) {
     // Standardize city names
     string standardStart = Graph::standardizeCity(startCity);
     string standardEnd = Graph::standardizeCity(endCity);
@@ -19,87 +18,56 @@ void Dijkstra::dijkstra(Graph& graph, const string& startCity, const string& end
         return;
     }
     
-    // Initialize data structures
-    unordered_map<string, int> distances;
-
-
-    unordered_map<string, string> previous;
-
-
-    priority_queue<pair<int, string>, 
-                  vector<pair<int, string>>, 
-                  greater<pair<int, string>>> pq;
-                  
-    for (const auto& [city, _] : adjList) {
-        distances[city] = numeric_limits<int>::max();
-    }
-    distances[standardStart] = 0;
-    pq.push({0, standardStart});
-    
-    while (!pq.empty()) {
-        string current = pq.top().second;
-        int currentDist = pq.top().first;
-        pq.pop();
-        
-        // If we've found a better path to current, skip
-        if (currentDist > distances[current]) continue;
-        
-        // If we've reached the end city, we're done
-        if (current == standardEnd) break;
-        
-        // Check all neighbors
-        for (const auto& [neighbor, dist] : adjList.at(current)) {
-            int newDist = distances[current] + dist;
-            
-            if (newDist < distances[neighbor]) {
-                distances[neighbor] = newDist;
-                previous[neighbor] = current;
-                pq.push({newDist, neighbor});
-            }
-        }
-    }
+    PathResult result = PathEngine::find(graph, standardStart, standardEnd, algorithm);
     
     // If we couldn't reach the end city
-    if (distances[standardEnd] == numeric_limits<int>::max()) {
+    if (!result.found()) {
         cout << "No path exists between " << standardStart << " and " << standardEnd << ".\n";
+        if (result.ruledOut) {
+            cout << "(the one-way structure of the network rules it out; no search was needed)\n";
+        }
         return;
     }
     
-    // Reconstruct and display the path
-    vector<string> path = reconstructPath(previous, standardStart, standardEnd);
-    displayPath(path, distances[standardEnd]);
+    displayPath(graph, result);
 }
 
-// @rawanizzeldin write reconstructPath function here
-vector<string> Dijkstra::reconstructPath(const unordered_map<string, string>& previous,
-                                       const string& startCity,
-                                       const string& endCity) {
-    vector<string> path;
-    string current = endCity;
-    
-    while (current != startCity) {
-        path.push_back(current);
-        current = previous.at(current);
+vector<int> Dijkstra::distancesFrom(const CompactGraph& graph, int source) {
+    vector<int> distances(graph.nodeCount(), numeric_limits<int>::max());
+    if (source < 0 || source >= graph.nodeCount() || !graph.isAlive(source)) {
+        return distances;
     }
-    path.push_back(startCity);
     
-    reverse(path.begin(), path.end());
-    return path;
+    priority_queue<pair<int, int>, vector<pair<int, int>>, greater<pair<int, int>>> pq;
+    distances[source] = 0;
+    pq.push({0, source});
+    
+    while (!pq.empty()) {
+        auto [currentDist, current] = pq.top();
+        pq.pop();
+        if (currentDist > distances[current]) continue;
+        
+        for (int e = graph.offsets[current]; e < graph.offsets[current + 1]; ++e) {
+            int newDist = currentDist + graph.weights[e];
+            if (newDist < distances[graph.targets[e]]) {
+                distances[graph.targets[e]] = newDist;
+                pq.push({newDist, graph.targets[e]});
+            }
+        }
+    }
+    return distances;
 }
 
 // @expygmalion 
-void Dijkstra::displayPath(const vector<string>& path, int totalDistance) {
+void Dijkstra::displayPath(const Graph& graph, const PathResult& result) {
     cout << "\nShortest Path Found:\n";
-    cout << "Total Distance: " << totalDistance << " units\n";
-    cout << "Path: ";
-    
-    for (size_t i = 0; i < path.size(); ++i) {
-        cout << path[i];
-        if (i < path.size() - 1) {
-            cout << " -> ";
-        }
+    cout << "Total Distance: " << result.distance << " units\n";
+    cout << "Path: " << PathEngine::formatPath(graph, result.nodes) << "\n";
+    if (result.fromCache) {
+        cout << "(answered from the path cache)\n";
+    } else {
+        cout << "Settled " << result.settled << " cities in " << result.milliseconds << " ms\n";
     }
-    cout << "\n";
 } 
 
 
@@ -0,0 +1,221 @@
+#include "../include/Eccentricity.hpp"
+#include <iostream>
+#include <algorithm>
+#include <climits>
+
+using namespace std;
+
+int Eccentricity::sweep(const CompactGraph& graph, const StrongComponents& components, int source,
+                        bool forward, bool weighted, SearchWorkspace& workspace, int& farthest) {
+    const vector<int>& offsets = forward ? graph.offsets : graph.inOffsets;
+    const vector<int>& ends = forward ? graph.targets : graph.sources;
+    int component = components.componentOf(source);
+    auto length = [&](int slot) {
+        if (!weighted) return 1;
+        return graph.weights[forward ? slot : graph.inEdges[slot]];
+    };
+
+    workspace.begin(graph.nodeCount());
+    workspace.set(source, 0, -1);
+    farthest = source;
+    int eccentricity = 0;
+
+    if (!weighted) {
+        // BFS; reachedNodes() is already in distance order
+        const vector<int>& order = workspace.reachedNodes();
+        for (size_t head = 0; head < order.size(); ++head) {
+            int u = order[head];
+            int d = workspace.distance(u);
+            for (int slot = offsets[u]; slot < offsets[u + 1]; ++slot) {
+                int v = ends[slot];
+                if (components.componentOf(v) == component && workspace.distance(v) == INT_MAX) {
+                    workspace.set(v, d + 1, u);
+                }
+            }
+        }
+        farthest = order.back();
+        return workspace.distance(farthest);
+    }
+
+    workspace.push(0, source);
+    while (!workspace.empty()) {
+        auto [d, u] = workspace.pop();
+        if (d > workspace.distance(u)) continue;
+        if (d > eccentricity) {
+            eccentricity = d;
+            farthest = u;
+        }
+        for (int slot = offsets[u]; slot < offsets[u + 1]; ++slot) {
+            int v = ends[slot];
+            int nd = d + length(slot);
+            // A shortest path between two cities of a component never leaves it
+            if (components.componentOf(v) == component && nd < workspace.distance(v)) {
+                workspace.set(v, nd, u);
+                workspace.push(nd, v);
+            }
+        }
+    }
+    return eccentricity;
+}
+
+EccentricityResult Eccentricity::compute(const CompactGraph& graph, const StrongComponents& components,
+                                         bool weighted, bool everyCity, int searchLimit) {
+    EccentricityResult result;
+    result.weighted = weighted;
+    result.eccentricity.assign(graph.nodeCount(), -1);
+    result.component = components.largestComponent();
+    if (result.component < 0) {
+        return result;
+    }
+
+    vector<int> members;
+    for (int u = 0; u < graph.nodeCount(); ++u) {
+        if (graph.isAlive(u) && components.componentOf(u) == result.component) {
+            members.push_back(u);
+        }
+    }
+    result.cities = static_cast<int>(members.size());
+
+    vector<int> lower(graph.nodeCount(), 0);
+    vector<int> upper(graph.nodeCount(), INT_MAX);
+    vector<int> candidates = members;
+    SearchWorkspace forward, backward;
+    bool pickLargestUpper = true;
+
+    while (!candidates.empty()) {
+        if (searchLimit > 0 && result.searches + 2 > searchLimit) {
+            break;
+        }
+        // Ties go to the busier city, which tends to tighten more bounds
+        auto degree = [&](int u) { return graph.outDegree(u) + graph.inDegree(u); };
+        int v = *min_element(candidates.begin(), candidates.end(), [&](int a, int b) {
+            if (pickLargestUpper) {
+                return upper[a] != upper[b] ? upper[a] > upper[b] : degree(a) > degree(b);
+            }
+            return lower[a] != lower[b] ? lower[a] < lower[b] : degree(a) > degree(b);
+        });
+        pickLargestUpper = !pickLargestUpper;
+
+        int farthest, ignored;
+        int eccentricity = sweep(graph, components, v, true, weighted, forward, farthest);
+        sweep(graph, components, v, false, weighted, backward, ignored);
+        result.searches += 2;
+        if (result.diameterFrom == -1 || eccentricity > result.diameter) {
+            result.diameter = eccentricity;
+            result.diameterFrom = v;
+            result.diameterTo = farthest;
+        }
+
+        // Bounds tighten for every city, including ones no longer searched for
+        int widestLower = 0;
+        int narrowestUpper = INT_MAX;
+        for (int w : members) {
+            int toV = backward.distance(w);
+            int fromV = forward.distance(w);
+            lower[w] = max(lower[w], max(toV, eccentricity - fromV));
+            upper[w] = min(upper[w], toV + eccentricity);
+            widestLower = max(widestLower, lower[w]);
+            narrowestUpper = min(narrowestUpper, upper[w]);
+        }
+        lower[v] = upper[v] = eccentricity;
+
+        // Without every eccentricity, a city that can neither be on the
+        // diameter nor be a center needs no search either
+        candidates.erase(remove_if(candidates.begin(), candidates.end(), [&](int w) {
+            return lower[w] == upper[w] ||
+                   (!everyCity && upper[w] <= widestLower && lower[w] >= narrowestUpper);
+        }), candidates.end());
+    }
+
+    // Diameter, radius and center; pruned cities cannot beat either bound
+    int widest = -1;
+    result.diameterUpper = 0;
+    result.radiusLower = INT_MAX;
+    for (int u : members) {
+        if (lower[u] == upper[u]) {
+            result.eccentricity[u] = lower[u];
+        }
+        if (widest == -1 || lower[u] > lower[widest]) {
+            widest = u;
+        }
+        if (result.center == -1 || upper[u] < result.radius) {
+            result.radius = upper[u];
+            result.center = u;
+        }
+        result.diameterUpper = max(result.diameterUpper, upper[u]);
+        result.radiusLower = min(result.radiusLower, lower[u]);
+    }
+    result.exact = candidates.empty();
+    if (result.exact && lower[widest] > result.diameter) {
+        // Known from bounds alone; one more search finds the far end
+        result.diameter = sweep(graph, components, widest, true, weighted, forward, result.diameterTo);
+        result.diameterFrom = widest;
+        result.searches++;
+    }
+    if (result.exact) {
+        result.diameterUpper = result.diameter;
+        result.radiusLower = result.radius;
+    }
+    return result;
+}
+
+int Eccentricity::of(const CompactGraph& graph, const StrongComponents& components, int city, bool weighted) {
+    if (city < 0 || city >= graph.nodeCount() || !graph.isAlive(city) ||
+        components.componentOf(city) != components.largestComponent()) {
+        return -1;
+    }
+    int farthest;
+    return sweep(graph, components, city, true, weighted, SearchWorkspace::local(), farthest);
+}
+
+void Eccentricity::showDiameter(Graph& graph) {
+    auto compact = graph.compact();
+    auto components = graph.strongComponents();
+    if (components->largestComponent() < 0) {
+        cout << "The graph is empty.\n";
+        return;
+    }
+
+    EccentricityResult results[2];
+    for (int weighted = 0; weighted < 2; ++weighted) {
+        results[weighted] = compute(*compact, *components, weighted == 1, false, CLI_SEARCH_LIMIT);
+    }
+
+    const EccentricityResult& hops = results[0];
+    cout << "\nLargest strongly connected component: " << hops.cities << " of "
+         << compact->liveCount << " cities\n";
+    for (const auto& result : results) {
+        const char* unit = result.weighted ? "" : " hops";
+        cout << (result.weighted ? "Distance" : "Hop") << " diameter: " << result.diameter << unit
+             << " (" << graph.cityName(result.diameterFrom) << " -> " << graph.cityName(result.diameterTo) << ")";
+        if (!result.exact) {
+            cout << ", at most " << result.diameterUpper;
+        }
+        cout << "\n  Radius: ";
+        if (!result.exact) {
+            cout << "between " << result.radiusLower << " and ";
+        }
+        cout << result.radius << unit << ", center " << graph.cityName(result.center)
+             << "; " << result.searches << " searches instead of " << result.cities << "\n";
+        if (!result.exact) {
+            cout << "  Search limit reached; the bounds did not close (typical of random, expander-like graphs).\n";
+        }
+    }
+
+    string city;
+    cout << "Enter a city to see its eccentricity (or type 'back' to return to main menu): ";
+    cin >> city;
+    if (city == "back" || city == "BACK" || city == "Back") {
+        return;
+    }
+    int id = graph.cityId(Graph::standardizeCity(city));
+    if (id < 0) {
+        cout << "City " << Graph::standardizeCity(city) << " not found in the graph.\n";
+    } else if (components->componentOf(id) != components->largestComponent()) {
+        cout << graph.cityName(id) << " is outside the largest strongly connected component; "
+             << "some cities cannot reach it or be reached from it.\n";
+    } else {
+        cout << graph.cityName(id) << ": eccentricity " << of(*compact, *components, id, true)
+             << " by distance, " << of(*compact, *components, id, false) << " hops\n";
+    }
+}
@@ -17,7 +17,9 @@ void FindPath::UniversalFind(Graph& graph) {
     cout << "\n=== Path Finding Algorithms ===\n";
     cout << "1. Dijkstra's Algorithm\n";
     cout << "2. A* Algorithm\n";
-    cout << "Select algorithm (1-2): ";
+    cout << "3. Dijkstra with arc-flags (precomputed on first use)\n";
+    cout << "4. Customizable route planning (multi-level overlay)\n";
+    cout << "Select algorithm (1-4): ";
     cin >> choice;
     
     if (cin.fail()) {
@@ -76,8 +78,20 @@ void FindPath::UniversalFind(Graph& graph) {
         case 2:
             AStar::findPath(graph, startCity, endCity);
             break;
+        case 3:
+            if (!graph.hasArcFlags()) {
+                cout << "Precomputing arc-flags...\n";
+            }
+            Dijkstra::dijkstra(graph, startCity, endCity, PathAlgorithm::ArcFlags);
+            break;
+        case 4:
+            if (!graph.hasCustomizedRoutes()) {
+                cout << "Customizing the overlay for the current distances...\n";
+            }
+            Dijkstra::dijkstra(graph, startCity, endCity, PathAlgorithm::Crp);
+            break;
         default:
-            cout << "Invalid choice. Please select 1 or 2.\n";
+            cout << "Invalid choice. Please select 1 to 4.\n";
     }
 }
 
@@ -22,12 +22,141 @@ bool Graph::cityExists(const string& city) const {
     return adjList.find(standardizedCity) != adjList.end();
 }
 
+// Look up the stable id of a city
+int Graph::cityId(const string& city) const {
+    auto it = cityIds.find(standardizeCity(city));
+    return it == cityIds.end() ? -1 : it->second;
+}
+
+const string& Graph::cityName(int id) const {
+    return cityNames.at(id);
+}
+
+shared_ptr<const CompactGraph> Graph::compact() const {
+    return compactSlot.get(graphVersion, [this]() {
+        return make_shared<const CompactGraph>(CompactGraph::build(*this));
+    });
+}
+
+shared_ptr<const ArcFlags> Graph::arcFlags() const {
+    return arcFlagsSlot.get(graphVersion, [this]() {
+        return make_shared<const ArcFlags>(ArcFlags::build(*compact(), 0, ThreadPool::shared()));
+    });
+}
+
+shared_ptr<const CustomizedRoutes> Graph::customizedRoutes() const {
+    return routesSlot.get(graphVersion, [this]() {
+        auto partition = partitionSlot.get(topologyCounter, [this]() {
+            return make_shared<const MultiLevelPartition>(MultiLevelPartition::build(*compact()));
+        });
+        return make_shared<const CustomizedRoutes>(
+            CustomizedRoutes::customize(partition, *compact(), ThreadPool::shared()));
+    });
+}
+
+bool Graph::sameComponent(const string& a, const string& b) const {
+    int first = cityId(a);
+    int second = cityId(b);
+    if (first < 0 || second < 0) {
+        return false;
+    }
+    if (islandsStale) {
+        rebuildIslands();
+    }
+    return islands.find(first) == islands.find(second);
+}
+
+int Graph::componentCount() const {
+    if (islandsStale) {
+        rebuildIslands();
+    }
+    // Deleted cities are left behind as singleton sets
+    return islands.setCount() - static_cast<int>(cityNames.size() - cityIds.size());
+}
+
+void Graph::rebuildIslands() const {
+    islands.clear();
+    for (size_t id = 0; id < cityNames.size(); ++id) {
+        islands.add();
+    }
+    for (const auto& [city, neighbors] : adjList) {
+        int from = cityIds.at(city);
+        for (const auto& [neighbor, _] : neighbors) {
+            islands.unite(from, cityIds.at(neighbor));
+        }
+    }
+    islandsStale = false;
+}
+
+shared_ptr<const StrongComponents> Graph::strongComponents() const {
+    return componentsSlot.get(topologyCounter, [this]() {
+        return make_shared<const StrongComponents>(StrongComponents::build(*compact()));
+    });
+}
+
+shared_ptr<const ReachabilityIndex> Graph::reachability() const {
+    return reachabilitySlot.get(topologyCounter, [this]() {
+        return make_shared<const ReachabilityIndex>(ReachabilityIndex::build(strongComponents()));
+    });
+}
+
+void Graph::bumpVersion(const function<bool(const CachedPath&)>& isStale, bool topologyChanged) {
+    if (topologyChanged) {
+        topologyCounter++;
+    }
+    unsigned long previous = graphVersion++;
+    cache.advance(previous, graphVersion, isStale);
+}
+
+// Whether a cached path walks along the edge from -> to
+static bool usesEdge(const CachedPath& entry, int fromId, int toId) {
+    for (size_t i = 1; i < entry.nodes.size(); ++i) {
+        if (entry.nodes[i - 1] == fromId && entry.nodes[i] == toId) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Drop one directed edge from a connection list, returning its distance (-1 if absent)
+static int eraseConnection(vector<pair<string, int>>& connections, const string& city) {
+    int distance = -1;
+    connections.erase(
+        remove_if(connections.begin(), connections.end(),
+            [&city, &distance](const pair<string, int>& connection) {
+                if (connection.first != city) return false;
+                distance = connection.second;
+                return true;
+            }
+        ),
+        connections.end()
+    );
+    return distance;
+}
+
+void Graph::clear() {
+    adjList.clear();
+    inAdjList.clear();
+    cityIds.clear();
+    cityNames.clear();
+    islands.clear();
+    islandsStale = false;
+    bumpVersion([](const CachedPath&) { return true; });
+    observers.notify([](GraphObserver& observer) { observer.onGraphCleared(); });
+}
+
 // Add a city (node) to the graph
 void Graph::addCity(const string& city) {
     string standardizedCity = standardizeCity(city);
     
     if (adjList.find(standardizedCity) == adjList.end()) {
         adjList[standardizedCity];  // Ensures the city exists by adding an empty list if not already present
+        inAdjList[standardizedCity];
+        cityIds[standardizedCity] = static_cast<int>(cityNames.size());
+        cityNames.push_back(standardizedCity);
+        islands.add();
+        // A new isolated city cannot shorten any existing path
+        bumpVersion([](const CachedPath&) { return false; });
         cout << "City " << standardizedCity << " added.\n";
     } else {
         cout << "City " << standardizedCity << " already exists.\n";
@@ -58,6 +187,15 @@ void Graph::addEdge(const string& from, const string& to, int dist) {
     }
 
     adjList[standardizedFrom].emplace_back(standardizedTo, dist);  // Add edge only from 'from' to 'to' (directed)
+    inAdjList[standardizedTo].emplace_back(standardizedFrom, dist);
+    if (!islandsStale) {
+        islands.unite(cityIds[standardizedFrom], cityIds[standardizedTo]);
+    }
+    // A new edge may shorten any cached path
+    bumpVersion([](const CachedPath&) { return true; });
+    observers.notify([&](GraphObserver& observer) {
+        observer.onEdgeAdded(standardizedFrom, standardizedTo, dist);
+    });
     cout << "Directed edge added from " << standardizedFrom << " to " << standardizedTo << " with distance " << dist << ".\n";
 }
 
@@ -86,6 +224,9 @@ void Graph::display() const {
         cout << "\n";
     }
     cout << "\nTotal cities: " << adjList.size() << "\n";
+    cout << "Islands (cities linked in either direction): " << componentCount() << "\n";
+    cout << "Path cache: " << cache.hits() << " hits, " << cache.misses() << " misses, "
+         << cache.size() << " entries\n";
 }
 
 void Graph::deleteCity(string name) {
@@ -96,20 +237,28 @@ void Graph::deleteCity(string name) {
         return;
     }
 
-    // Remove all edges connected to this city
-    for (auto& [city, neighbors] : adjList) {
-        neighbors.erase(
-            remove_if(neighbors.begin(), neighbors.end(),
-                [&standardizedName](const pair<string, int>& neighbor) { 
-                    return neighbor.first == standardizedName; 
-                }
-            ),
-            neighbors.end()
-        );
+    // Remove all edges connected to this city, visiting only its neighbors
+    for (const auto& [source, _] : inAdjList[standardizedName]) {
+        eraseConnection(adjList[source], standardizedName);
+    }
+    for (const auto& [target, _] : adjList[standardizedName]) {
+        eraseConnection(inAdjList[target], standardizedName);
     }
 
     // Remove the city
     adjList.erase(standardizedName);
+    inAdjList.erase(standardizedName);
+
+    // Only paths that started, ended or passed through the city are affected
+    int removedId = cityIds[standardizedName];
+    cityIds.erase(standardizedName);
+    cityNames[removedId].clear();
+    islandsStale = true;
+    bumpVersion([removedId](const CachedPath& entry) {
+        return entry.source == removedId || entry.target == removedId ||
+               find(entry.nodes.begin(), entry.nodes.end(), removedId) != entry.nodes.end();
+    });
+    observers.notify([&](GraphObserver& observer) { observer.onCityRemoved(standardizedName, removedId); });
     cout << "City " << standardizedName << " and all its connections have been removed.\n";
 }
 
@@ -129,6 +278,8 @@ void Graph::sortConnections(bool byDistance) {
                 });
         }
     }
+    // Neighbor order only affects tie-breaking, cached paths remain shortest
+    bumpVersion([](const CachedPath&) { return false; }, false);
     cout << "All connections have been sorted " 
          << (byDistance ? "by distance." : "by city name.") << endl;
 }
@@ -148,21 +299,68 @@ void Graph::deleteEdge(string from, string to) {
     }
 
     // Remove the directed edge from 'from' to 'to'
-    auto& neighbors = adjList[standardizedFrom];
-    auto sizeBefore = neighbors.size();
+    int removedDistance = eraseConnection(adjList[standardizedFrom], standardizedTo);
     
-    neighbors.erase(
-        remove_if(neighbors.begin(), neighbors.end(),
-            [&standardizedTo](const pair<string, int>& neighbor) { 
-                return neighbor.first == standardizedTo; 
-            }
-        ),
-        neighbors.end()
-    );
-    
-    if (neighbors.size() < sizeBefore) {
+    if (removedDistance >= 0) {
+        eraseConnection(inAdjList[standardizedTo], standardizedFrom);
+        islandsStale = true;
+        
+        // Only paths that used the removed edge are affected
+        int fromId = cityIds[standardizedFrom];
+        int toId = cityIds[standardizedTo];
+        bumpVersion([fromId, toId](const CachedPath& entry) {
+            return usesEdge(entry, fromId, toId);
+        });
+        observers.notify([&](GraphObserver& observer) {
+            observer.onEdgeRemoved(standardizedFrom, standardizedTo, removedDistance);
+        });
         cout << "Directed edge from " << standardizedFrom << " to " << standardizedTo << " removed successfully.\n";
     } else {
         cout << "No edge found from " << standardizedFrom << " to " << standardizedTo << ".\n";
     }
-}
\ No newline at end of file
+}
+
+// Change the distance of an existing edge
+void Graph::updateEdge(const string& from, const string& to, int distance) {
+    string standardizedFrom = standardizeCity(from);
+    string standardizedTo = standardizeCity(to);
+    
+    if (!cityExists(standardizedFrom) || !cityExists(standardizedTo)) {
+        cout << "One or both cities not found in the graph.\n";
+        return;
+    }
+    
+    auto& neighbors = adjList[standardizedFrom];
+    auto edge = find_if(neighbors.begin(), neighbors.end(),
+        [&standardizedTo](const pair<string, int>& neighbor) {
+            return neighbor.first == standardizedTo;
+        });
+    if (edge == neighbors.end()) {
+        cout << "No edge found from " << standardizedFrom << " to " << standardizedTo << ".\n";
+        return;
+    }
+    
+    int oldDistance = edge->second;
+    if (oldDistance == distance) {
+        cout << "Edge from " << standardizedFrom << " to " << standardizedTo << " already has distance " << distance << ".\n";
+        return;
+    }
+    edge->second = distance;
+    for (auto& incoming : inAdjList[standardizedTo]) {
+        if (incoming.first == standardizedFrom) {
+            incoming.second = distance;
+        }
+    }
+    
+    // A longer edge only affects paths that used it; a shorter one may improve any path
+    int fromId = cityIds[standardizedFrom];
+    int toId = cityIds[standardizedTo];
+    bumpVersion([fromId, toId, distance, oldDistance](const CachedPath& entry) {
+        return distance < oldDistance || usesEdge(entry, fromId, toId);
+    }, false);
+    observers.notify([&](GraphObserver& observer) {
+        observer.onEdgeWeightChanged(standardizedFrom, standardizedTo, oldDistance, distance);
+    });
+    cout << "Distance from " << standardizedFrom << " to " << standardizedTo << " changed from "
+         << oldDistance << " to " << distance << ".\n";
+}
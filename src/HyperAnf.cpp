@@ -0,0 +1,250 @@
+#include "../include/HyperAnf.hpp"
+#include "../include/Traversal.hpp"
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+using namespace std;
+
+namespace {
+
+const int REGISTERS_PER_WORD = 8;
+const uint64_t HIGH_BITS = 0x8080808080808080ULL;
+// Share of the connected pairs the effective diameter covers
+const double EFFECTIVE_SHARE = 0.9;
+// Distribution rows the CLI prints before eliding the tail
+const int CLI_ROWS = 40;
+
+// SplitMix64 finaliser; spreads consecutive city ids over the whole range
+uint64_t mix(uint64_t x) {
+    x += 0x9E3779B97F4A7C15ULL;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    return x ^ (x >> 31);
+}
+
+int leadingZeros(uint64_t bits) {
+#if defined(__GNUC__)
+    return __builtin_clzll(bits);
+#else
+    int zeros = 0;
+    while (!(bits & (uint64_t(1) << 63))) {
+        bits <<= 1;
+        ++zeros;
+    }
+    return zeros;
+#endif
+}
+
+// Byte-wise maximum of eight registers. Registers stay below 128, so the top
+// bit of every byte is free: (x | 0x80) - y keeps it exactly where x >= y.
+uint64_t registerMax(uint64_t x, uint64_t y) {
+    uint64_t atLeast = ((x | HIGH_BITS) - y) & HIGH_BITS;
+    uint64_t mask = (atLeast - (atLeast >> 7)) | atLeast;
+    return (x & mask) | (y & ~mask);
+}
+
+// HyperLogLog estimate with the linear-counting correction for small sets
+class CounterEstimator {
+public:
+    explicit CounterEstimator(int registers) : registers(registers) {
+        alpha = registers == 16 ? 0.673 : registers == 32 ? 0.697 : registers == 64 ? 0.709
+              : 0.7213 / (1 + 1.079 / registers);
+        for (int k = 0; k < 65; ++k) {
+            powers[k] = ldexp(1.0, -k);
+        }
+    }
+
+    double operator()(const uint64_t* words) const {
+        double sum = 0;
+        int zeros = 0;
+        for (int w = 0; w < registers / REGISTERS_PER_WORD; ++w) {
+            uint64_t word = words[w];
+            for (int r = 0; r < REGISTERS_PER_WORD; ++r) {
+                int value = static_cast<int>((word >> (8 * r)) & 0xFF);
+                sum += powers[value];
+                zeros += value == 0;
+            }
+        }
+        double raw = alpha * registers * registers / sum;
+        if (raw <= 2.5 * registers && zeros > 0) {
+            return registers * log(static_cast<double>(registers) / zeros);
+        }
+        return raw;
+    }
+
+private:
+    int registers;
+    double alpha;
+    double powers[65];
+};
+
+}  // namespace
+
+NeighbourhoodFunction HyperAnf::estimate(const CompactGraph& graph, ThreadPool& pool, int log2Registers,
+                                         int maxIterations, unsigned long long seed) {
+    NeighbourhoodFunction result;
+    int bits = max(MIN_LOG2_REGISTERS, min(MAX_LOG2_REGISTERS, log2Registers));
+    int registers = 1 << bits;
+    int words = registers / REGISTERS_PER_WORD;
+    int n = graph.nodeCount();
+    result.registers = registers;
+    result.reachable.assign(n, 0);
+
+    // Step 0: every city's counter holds just the city
+    vector<uint64_t> current(static_cast<size_t>(n) * words, 0);
+    uint64_t salt = mix(seed);
+    for (int x = 0; x < n; ++x) {
+        if (!graph.isAlive(x)) continue;
+        uint64_t hash = mix(static_cast<uint64_t>(x) ^ salt);
+        int index = static_cast<int>(hash >> (64 - bits));
+        uint64_t rest = hash << bits;
+        uint64_t rank = rest ? leadingZeros(rest) + 1 : 64 - bits + 1;
+        current[static_cast<size_t>(x) * words + index / REGISTERS_PER_WORD] |=
+            rank << (8 * (index % REGISTERS_PER_WORD));
+    }
+    vector<uint64_t> next = current;
+
+    CounterEstimator count(registers);
+    vector<double>& estimate = result.reachable;
+    double pairs = 0;
+    for (int x = 0; x < n; ++x) {
+        if (!graph.isAlive(x)) continue;
+        estimate[x] = count(&current[static_cast<size_t>(x) * words]);
+        pairs += estimate[x];
+    }
+    result.pairs.push_back(pairs);
+
+    // changed[x]: x's counter grew in the last step. next[x] still holds the
+    // counter from the step before, so it only needs a copy when x changed.
+    vector<char> changed(graph.alive.begin(), graph.alive.end());
+    vector<char> changedNow(n, 0);
+    vector<size_t> grown(pool.size());
+    while (maxIterations <= 0 || result.iterations < maxIterations) {
+        fill(grown.begin(), grown.end(), 0);
+        pool.parallelFor(n, [&](size_t i, unsigned worker) {
+            int x = static_cast<int>(i);
+            if (!graph.isAlive(x)) return;
+            const uint64_t* own = &current[i * words];
+            uint64_t* out = &next[i * words];
+
+            bool dirty = false;
+            for (int e = graph.offsets[x]; e < graph.offsets[x + 1] && !dirty; ++e) {
+                dirty = changed[graph.targets[e]] != 0;
+            }
+            if (!dirty) {
+                if (changed[x]) memcpy(out, own, words * sizeof(uint64_t));
+                changedNow[x] = 0;
+                return;
+            }
+
+            memcpy(out, own, words * sizeof(uint64_t));
+            for (int e = graph.offsets[x]; e < graph.offsets[x + 1]; ++e) {
+                const uint64_t* other = &current[static_cast<size_t>(graph.targets[e]) * words];
+                for (int w = 0; w < words; ++w) {
+                    out[w] = registerMax(out[w], other[w]);
+                }
+            }
+            bool differs = false;
+            for (int w = 0; w < words && !differs; ++w) {
+                differs = out[w] != own[w];
+            }
+            changedNow[x] = differs;
+            if (differs) {
+                estimate[x] = max(estimate[x], count(out));
+                grown[worker]++;
+            }
+        }, 256);
+
+        current.swap(next);
+        changed.swap(changedNow);
+        size_t total = 0;
+        for (size_t g : grown) total += g;
+        if (total == 0) {
+            result.converged = true;
+            break;
+        }
+
+        // Summed serially so the estimate does not depend on the thread count
+        pairs = 0;
+        for (int x = 0; x < n; ++x) {
+            pairs += estimate[x];
+        }
+        result.pairs.push_back(max(pairs, result.pairs.back()));
+        result.iterations++;
+    }
+
+    // Distance distribution over the pairs joined by a path
+    double self = result.pairs.front();
+    double connected = result.pairs.back() - self;
+    if (connected > 0) {
+        double weighted = 0;
+        for (size_t t = 1; t < result.pairs.size(); ++t) {
+            weighted += t * (result.pairs[t] - result.pairs[t - 1]);
+        }
+        result.averageDistance = weighted / connected;
+
+        double target = self + EFFECTIVE_SHARE * connected;
+        for (size_t t = 1; t < result.pairs.size(); ++t) {
+            if (result.pairs[t] >= target) {
+                double step = result.pairs[t] - result.pairs[t - 1];
+                result.effectiveDiameter = (t - 1) + (step > 0 ? (target - result.pairs[t - 1]) / step : 1.0);
+                break;
+            }
+        }
+    }
+    return result;
+}
+
+void HyperAnf::showStatistics(Graph& graph) {
+    auto compact = graph.compact();
+    if (compact->liveCount == 0) {
+        cout << "The graph is empty.\n";
+        return;
+    }
+
+    NeighbourhoodFunction result = estimate(*compact, ThreadPool::shared());
+    double self = result.pairs.front();
+    double connected = result.pairs.back() - self;
+    cout << fixed << setprecision(2);
+    cout << "\nHyperANF over " << compact->liveCount << " cities, " << result.registers
+         << " registers per city (about +-" << 104.0 / sqrt(static_cast<double>(result.registers))
+         << "% per city)\n";
+    cout << "Counters settled after " << result.iterations << " hops\n";
+    cout << "Connected pairs (estimated): " << setprecision(0) << connected << setprecision(2) << "\n";
+    cout << "Average distance: " << result.averageDistance << " hops\n";
+    cout << "Effective diameter (90% of pairs): " << result.effectiveDiameter << " hops\n";
+
+    if (connected > 0) {
+        cout << "\n Hops   Pairs at this distance   Cumulative\n";
+        int rows = min(static_cast<int>(result.pairs.size()) - 1, CLI_ROWS);
+        for (int t = 1; t <= rows; ++t) {
+            cout << setw(5) << t << "   " << setw(22) << setprecision(0) << result.pairs[t] - result.pairs[t - 1]
+                 << "   " << setw(9) << setprecision(2) << 100.0 * (result.pairs[t] - self) / connected << "%\n";
+        }
+        if (rows < static_cast<int>(result.pairs.size()) - 1) {
+            cout << "  ... " << result.pairs.size() - 1 - rows << " more hops\n";
+        }
+    }
+    cout.unsetf(ios::fixed);
+    cout << setprecision(6);
+
+    string city;
+    cout << "Enter a city to compare its estimated reach with an exact count (or type 'back' to return to main menu): ";
+    cin >> city;
+    if (city == "back" || city == "BACK" || city == "Back") {
+        return;
+    }
+    int id = graph.cityId(Graph::standardizeCity(city));
+    if (id < 0) {
+        cout << "City " << Graph::standardizeCity(city) << " not found in the graph.\n";
+        return;
+    }
+    HopTree hops = Traversal::hopDistances(*compact, id);
+    long long exact = count_if(hops.hops.begin(), hops.hops.end(), [](int h) { return h >= 0; });
+    cout << graph.cityName(id) << " reaches about " << llround(result.reachable[id])
+         << " cities, itself included (exact: " << exact << ")\n";
+}
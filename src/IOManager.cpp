@@ -60,6 +60,12 @@ void IOManager::saveGraph(const string& filename, const Graph& graph)
 	
 	file.close();
 	cout << "Graph saved to " + filePath << endl;
+	
+	// Persist precomputed arc-flags next to the graph
+	if (graph.hasArcFlags()) {
+		graph.arcFlags()->save(filePath + ".flags", graph, *graph.compact());
+		cout << "Arc-flags saved to " + filePath + ".flags" << endl;
+	}
 }
 
 void IOManager::loadGraph(const string& filename, Graph& graph)
@@ -77,10 +83,8 @@ void IOManager::loadGraph(const string& filename, Graph& graph)
 		throw runtime_error(errorMsg);
 	}
 	
-	// Clear existing graph first
-	// Create a temporary empty graph and swap it with the current one
-	Graph emptyGraph;
-	graph = emptyGraph;
+	// Clear existing graph first, keeping anything observing it attached
+	graph.clear();
 	
 	string line;
 	vector<string> cities;
@@ -127,6 +131,13 @@ void IOManager::loadGraph(const string& filename, Graph& graph)
 		graph.addEdge(from, to, dist);
 	}
 	
+	// Pick up arc-flags saved with this graph, if they still match it
+	ArcFlags flags;
+	if (ArcFlags::load(filePath + ".flags", graph, *graph.compact(), flags)) {
+		graph.arcFlagsSlot.set(graph.version(), make_shared<const ArcFlags>(move(flags)));
+		cout << "Arc-flags loaded from " << filePath << ".flags" << endl;
+	}
+	
 	cout << "Graph loaded from " << filePath << endl;
 	cout << "Loaded " << cities.size() << " cities and " << edges.size() << " edges." << endl;
 }
@@ -0,0 +1,98 @@
+#include "../include/Isochrone.hpp"
+#include <iostream>
+#include <sstream>
+#include <limits>
+#include <algorithm>
+
+using namespace std;
+
+vector<int> Isochrone::normalizeBudgets(vector<int> budgets) {
+    budgets.erase(remove_if(budgets.begin(), budgets.end(), [](int b) { return b < 0; }), budgets.end());
+    sort(budgets.begin(), budgets.end());
+    budgets.erase(unique(budgets.begin(), budgets.end()), budgets.end());
+    return budgets;
+}
+
+vector<ReachableCity> Isochrone::reachable(const CompactGraph& graph, int source,
+                                           vector<int> budgets, SearchWorkspace& workspace) {
+    vector<ReachableCity> result;
+    budgets = normalizeBudgets(move(budgets));
+    if (budgets.empty() || source < 0 || source >= graph.nodeCount() || !graph.isAlive(source)) {
+        return result;
+    }
+
+    int limit = budgets.back();
+    workspace.begin(graph.nodeCount());
+    workspace.set(source, 0, -1);
+    workspace.push(0, source);
+
+    while (!workspace.empty()) {
+        auto [d, u] = workspace.pop();
+        if (d > workspace.distance(u)) continue;
+
+        // Cities are settled in distance order, so the band only ever grows
+        int band = lower_bound(budgets.begin(), budgets.end(), d) - budgets.begin();
+        result.push_back({u, d, band});
+
+        for (int e = graph.offsets[u]; e < graph.offsets[u + 1]; ++e) {
+            int v = graph.targets[e];
+            int nd = d + graph.weights[e];
+            // Never queue anything past the largest budget
+            if (nd <= limit && nd < workspace.distance(v)) {
+                workspace.set(v, nd, u);
+                workspace.push(nd, v);
+            }
+        }
+    }
+    return result;
+}
+
+vector<ReachableCity> Isochrone::reachable(const Graph& graph, const string& sourceCity,
+                                           const vector<int>& budgets) {
+    return reachable(*graph.compact(), graph.cityId(Graph::standardizeCity(sourceCity)),
+                     budgets, SearchWorkspace::local());
+}
+
+void Isochrone::findReachable(Graph& graph) {
+    string sourceCity;
+    cout << "Enter hub city (or type 'back' to return to main menu): ";
+    cin >> sourceCity;
+    if (sourceCity == "back" || sourceCity == "BACK" || sourceCity == "Back") {
+        return;
+    }
+    sourceCity = Graph::standardizeCity(sourceCity);
+    if (!graph.cityExists(sourceCity)) {
+        cout << "City " << sourceCity << " not found in the graph.\n";
+        return;
+    }
+
+    cout << "Enter one or more budgets separated by spaces (e.g. 10 20 30): ";
+    cin.ignore(numeric_limits<streamsize>::max(), '\n');
+    string line;
+    getline(cin, line);
+    istringstream iss(line);
+    vector<int> budgets;
+    int budget;
+    while (iss >> budget) {
+        budgets.push_back(budget);
+    }
+    budgets = normalizeBudgets(budgets);
+    if (budgets.empty()) {
+        cout << "No valid budgets given.\n";
+        return;
+    }
+
+    vector<ReachableCity> cities = reachable(graph, sourceCity, budgets);
+    size_t next = 0;
+    for (size_t band = 0; band < budgets.size(); ++band) {
+        size_t bandStart = next;
+        while (next < cities.size() && cities[next].band == static_cast<int>(band)) {
+            next++;
+        }
+        cout << "\nWithin " << budgets[band] << " of " << sourceCity << ": "
+             << next << " cities (" << next - bandStart << " new)\n";
+        for (size_t i = bandStart; i < next; ++i) {
+            cout << "  " << graph.cityName(cities[i].city) << " (" << cities[i].distance << ")\n";
+        }
+    }
+}
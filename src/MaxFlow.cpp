@@ -0,0 +1,308 @@
+#include "../include/MaxFlow.hpp"
+#include "../include/Graph.hpp"
+#include <iostream>
+#include <algorithm>
+
+using namespace std;
+
+namespace {
+
+// Relabel work, in arcs scanned plus a constant per relabel, that triggers a
+// global relabel once it exceeds twice ALPHA * cities + arcs (Cherkassky & Goldberg)
+const long long GLOBAL_RELABEL_ALPHA = 6;
+const long long RELABEL_COST = 12;
+
+// Residual network: every road u -> v gives a forward arc at u with its
+// capacity and a reverse arc at v with none; mate links the two
+struct ResidualNetwork {
+    vector<int> first;      // Arcs of u are [first[u], first[u + 1])
+    vector<int> head;
+    vector<int> mate;
+    vector<int> residual;
+
+    explicit ResidualNetwork(const CompactGraph& graph) {
+        int n = graph.nodeCount();
+        first.assign(n + 1, 0);
+        for (int u = 0; u < n; ++u) {
+            first[u + 1] = first[u] + graph.outDegree(u) + graph.inDegree(u);
+        }
+        int arcs = first[n];
+        head.resize(arcs);
+        mate.resize(arcs);
+        residual.assign(arcs, 0);
+
+        vector<int> fill(first.begin(), first.end() - 1);
+        for (int u = 0; u < n; ++u) {
+            for (int e = graph.offsets[u]; e < graph.offsets[u + 1]; ++e) {
+                int v = graph.targets[e];
+                int forward = fill[u]++;
+                int backward = fill[v]++;
+                head[forward] = v;
+                head[backward] = u;
+                mate[forward] = backward;
+                mate[backward] = forward;
+                residual[forward] = graph.weights[e];
+            }
+        }
+    }
+};
+
+class PushRelabel {
+public:
+    PushRelabel(const CompactGraph& graph, int source, int sink, FlowResult& result)
+        : net(graph), n(graph.nodeCount()), source(source), sink(sink), stats(result),
+          height(n, n), current(n), excess(n, 0),
+          labelHead(n, -1), labelNext(n, -1), labelPrev(n, -1),
+          activeHead(n, -1), activeNext(n, -1) {}
+
+    long long run() {
+        // Saturate every road out of the source, then start from exact labels
+        for (int a = net.first[source]; a < net.first[source + 1]; ++a) {
+            int delta = net.residual[a];
+            net.residual[a] = 0;
+            net.residual[net.mate[a]] += delta;
+            excess[net.head[a]] += delta;
+            excess[source] -= delta;
+        }
+        globalRelabel();
+
+        while (maxActive >= 0) {
+            if (work > 2 * (GLOBAL_RELABEL_ALPHA * n + static_cast<long long>(net.head.size()))) {
+                globalRelabel();
+                continue;
+            }
+            int v = activeHead[maxActive];
+            if (v < 0) {
+                maxActive--;
+                continue;
+            }
+            activeHead[maxActive] = activeNext[v];
+            discharge(v);
+        }
+        return excess[sink];
+    }
+
+    // Cities that can still reach the sink through unsaturated arcs
+    vector<char> sinkSide() const {
+        vector<char> reached(n, 0);
+        vector<int> queue{sink};
+        reached[sink] = 1;
+        for (size_t i = 0; i < queue.size(); ++i) {
+            int x = queue[i];
+            for (int a = net.first[x]; a < net.first[x + 1]; ++a) {
+                int y = net.head[a];
+                if (!reached[y] && net.residual[net.mate[a]] > 0) {
+                    reached[y] = 1;
+                    queue.push_back(y);
+                }
+            }
+        }
+        return reached;
+    }
+
+private:
+    void addToLabel(int v) {
+        int h = height[v];
+        labelPrev[v] = -1;
+        labelNext[v] = labelHead[h];
+        if (labelHead[h] >= 0) labelPrev[labelHead[h]] = v;
+        labelHead[h] = v;
+        maxLabel = max(maxLabel, h);
+    }
+
+    void removeFromLabel(int v) {
+        if (labelPrev[v] >= 0) {
+            labelNext[labelPrev[v]] = labelNext[v];
+        } else {
+            labelHead[height[v]] = labelNext[v];
+        }
+        if (labelNext[v] >= 0) labelPrev[labelNext[v]] = labelPrev[v];
+    }
+
+    void activate(int v) {
+        int h = height[v];
+        activeNext[v] = activeHead[h];
+        activeHead[h] = v;
+        maxActive = max(maxActive, h);
+    }
+
+    // Exact distances to the sink by a backward BFS; cities that cannot reach it get n
+    void globalRelabel() {
+        stats.globalRelabels++;
+        work = 0;
+        fill(height.begin(), height.end(), n);
+        fill(labelHead.begin(), labelHead.end(), -1);
+        fill(activeHead.begin(), activeHead.end(), -1);
+        maxLabel = -1;
+        maxActive = -1;
+
+        vector<int>& queue = bfsQueue;
+        queue.clear();
+        queue.push_back(sink);
+        height[sink] = 0;
+        for (size_t i = 0; i < queue.size(); ++i) {
+            int x = queue[i];
+            addToLabel(x);
+            if (x != sink && excess[x] > 0) activate(x);
+            for (int a = net.first[x]; a < net.first[x + 1]; ++a) {
+                int y = net.head[a];
+                if (height[y] == n && y != source && net.residual[net.mate[a]] > 0) {
+                    height[y] = height[x] + 1;
+                    queue.push_back(y);
+                }
+            }
+        }
+        for (int v : queue) {
+            current[v] = net.first[v];
+        }
+    }
+
+    // Nobody is left at label gap, so nothing above it can reach the sink
+    void gapRelabel(int gap) {
+        stats.gaps++;
+        for (int h = gap + 1; h <= maxLabel; ++h) {
+            for (int v = labelHead[h]; v >= 0; v = labelNext[v]) {
+                height[v] = n;
+            }
+            labelHead[h] = -1;
+            activeHead[h] = -1;
+        }
+        maxLabel = gap - 1;
+    }
+
+    void relabel(int v) {
+        stats.relabels++;
+        int old = height[v];
+        removeFromLabel(v);
+        if (labelHead[old] < 0) {
+            height[v] = n;
+            gapRelabel(old);
+            return;
+        }
+
+        int lowest = n;
+        int lowestArc = net.first[v];
+        for (int a = net.first[v]; a < net.first[v + 1]; ++a) {
+            if (net.residual[a] > 0 && height[net.head[a]] + 1 < lowest) {
+                lowest = height[net.head[a]] + 1;
+                lowestArc = a;
+            }
+        }
+        work += RELABEL_COST + (net.first[v + 1] - net.first[v]);
+        height[v] = lowest;
+        current[v] = lowestArc;
+        if (lowest < n) addToLabel(v);
+    }
+
+    // Push along admissible arcs until the excess is gone or v is cut off
+    void discharge(int v) {
+        while (true) {
+            int h = height[v];
+            int end = net.first[v + 1];
+            for (int a = current[v]; a < end; ++a) {
+                int w = net.head[a];
+                if (net.residual[a] == 0 || height[w] != h - 1) continue;
+
+                int delta = static_cast<int>(min<long long>(excess[v], net.residual[a]));
+                net.residual[a] -= delta;
+                net.residual[net.mate[a]] += delta;
+                if (w != sink && excess[w] == 0) activate(w);
+                excess[w] += delta;
+                excess[v] -= delta;
+                stats.pushes++;
+                if (excess[v] == 0) {
+                    current[v] = a;
+                    return;
+                }
+            }
+            relabel(v);
+            if (height[v] >= n) return;
+        }
+    }
+
+    ResidualNetwork net;
+    int n;
+    int source;
+    int sink;
+    FlowResult& stats;
+
+    vector<int> height;
+    vector<int> current;
+    vector<long long> excess;
+    // Every city below n, by label (doubly linked for the gap heuristic)
+    vector<int> labelHead, labelNext, labelPrev;
+    // Cities with excess, by label (highest label first)
+    vector<int> activeHead, activeNext;
+    vector<int> bfsQueue;
+    int maxLabel = -1;
+    int maxActive = -1;
+    long long work = 0;
+};
+
+}  // namespace
+
+FlowResult MaxFlow::compute(const CompactGraph& graph, int source, int sink) {
+    FlowResult result;
+    int n = graph.nodeCount();
+    result.sourceSide.assign(n, 0);
+    if (source < 0 || sink < 0 || source >= n || sink >= n || source == sink ||
+        !graph.isAlive(source) || !graph.isAlive(sink)) {
+        return result;
+    }
+
+    PushRelabel solver(graph, source, sink, result);
+    result.value = solver.run();
+
+    vector<char> sinkSide = solver.sinkSide();
+    for (int u = 0; u < n; ++u) {
+        result.sourceSide[u] = graph.isAlive(u) && !sinkSide[u];
+    }
+    for (int u = 0; u < n; ++u) {
+        if (!result.sourceSide[u]) continue;
+        for (int e = graph.offsets[u]; e < graph.offsets[u + 1]; ++e) {
+            if (sinkSide[graph.targets[e]]) {
+                result.cut.push_back({u, graph.targets[e], graph.weights[e]});
+            }
+        }
+    }
+    return result;
+}
+
+void MaxFlow::showCapacity(Graph& graph) {
+    string from, to;
+    cout << "Source city (or type 'back' to return to main menu): ";
+    cin >> from;
+    if (from == "back" || from == "BACK" || from == "Back") {
+        return;
+    }
+    cout << "Sink city (or type 'back' to return to main menu): ";
+    cin >> to;
+    if (to == "back" || to == "BACK" || to == "Back") {
+        return;
+    }
+
+    int source = graph.cityId(Graph::standardizeCity(from));
+    int sink = graph.cityId(Graph::standardizeCity(to));
+    if (source < 0 || sink < 0) {
+        cout << "City " << Graph::standardizeCity(source < 0 ? from : to) << " not found in the graph.\n";
+        return;
+    }
+    if (source == sink) {
+        cout << "Source and sink must be different cities.\n";
+        return;
+    }
+
+    auto compact = graph.compact();
+    FlowResult result = compute(*compact, source, sink);
+    cout << "\nMaximum flow from " << graph.cityName(source) << " to " << graph.cityName(sink)
+         << ": " << result.value << " (distances read as capacities)\n";
+    if (result.cut.empty()) {
+        cout << graph.cityName(sink) << " cannot be reached from " << graph.cityName(source) << ".\n";
+        return;
+    }
+    cout << "Minimum cut, " << result.cut.size() << " road(s):\n";
+    for (const auto& edge : result.cut) {
+        cout << "  " << graph.cityName(edge.from) << " -> " << graph.cityName(edge.to)
+             << " (capacity " << edge.capacity << ")\n";
+    }
+}
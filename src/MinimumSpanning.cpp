@@ -0,0 +1,325 @@
+#include "../include/MinimumSpanning.hpp"
+#include <atomic>
+#include <cstdint>
+#include <algorithm>
+
+using namespace std;
+
+static const uint64_t NO_EDGE = UINT64_MAX;
+
+// Orders edges by distance, then by edge id; negative distances sort first
+static uint64_t edgeKey(const CompactGraph& graph, int edge) {
+    uint32_t distance = static_cast<uint32_t>(graph.weights[edge]) ^ 0x80000000u;
+    return (static_cast<uint64_t>(distance) << 32) | static_cast<uint32_t>(edge);
+}
+
+SpanningStructure MinimumSpanning::forest(const CompactGraph& graph, ThreadPool& pool) {
+    int n = graph.nodeCount();
+    SpanningStructure result;
+
+    vector<int> edgeSource(graph.edgeCount());
+    pool.parallelFor(n, [&](size_t node, unsigned) {
+        int u = static_cast<int>(node);
+        for (int e = graph.offsets[u]; e < graph.offsets[u + 1]; ++e) {
+            edgeSource[e] = u;
+        }
+    }, 1024);
+
+    // component[u] is the representative city of u's tree so far
+    vector<int> component(n, -1);
+    for (int u = 0; u < n; ++u) {
+        if (graph.isAlive(u)) {
+            component[u] = u;
+            result.nodes.push_back(u);
+        }
+    }
+
+    // Edges still joining two different trees; each is seen once in the
+    // undirected view and offered to both ends
+    vector<int> crossing;
+    crossing.reserve(graph.edgeCount());
+    for (int e = 0; e < graph.edgeCount(); ++e) {
+        if (edgeSource[e] != graph.targets[e]) {
+            crossing.push_back(e);
+        }
+    }
+
+    vector<atomic<uint64_t>> cheapest(n);
+    for (auto& key : cheapest) {
+        key.store(NO_EDGE, memory_order_relaxed);
+    }
+    auto offer = [&](int c, uint64_t key) {
+        uint64_t current = cheapest[c].load(memory_order_relaxed);
+        while (key < current &&
+               !cheapest[c].compare_exchange_weak(current, key, memory_order_relaxed)) {
+        }
+    };
+
+    vector<int> roots = result.nodes;
+    vector<int> next(n), jumped(n);
+    vector<int> chosen(n, -1);
+    while (!crossing.empty()) {
+        pool.parallelFor(crossing.size(), [&](size_t i, unsigned) {
+            int e = crossing[i];
+            uint64_t key = edgeKey(graph, e);
+            offer(component[edgeSource[e]], key);
+            offer(component[graph.targets[e]], key);
+        }, 4096);
+
+        // Every tree points at the tree across its cheapest edge. With a strict
+        // edge order the only cycles are pairs sharing one edge; the lower id
+        // of each pair stays a root and the other one keeps the edge.
+        pool.parallelFor(roots.size(), [&](size_t i, unsigned) {
+            int c = roots[i];
+            uint64_t key = cheapest[c].load(memory_order_relaxed);
+            if (key == NO_EDGE) {
+                next[c] = c;
+                return;
+            }
+            int e = static_cast<int>(key & 0xffffffffu);
+            int other = component[edgeSource[e]] == c ? component[graph.targets[e]] : component[edgeSource[e]];
+            next[c] = other;
+            chosen[c] = e;
+        }, 1024);
+        pool.parallelFor(roots.size(), [&](size_t i, unsigned) {
+            int c = roots[i];
+            cheapest[c].store(NO_EDGE, memory_order_relaxed);
+            int other = next[c];
+            if (other != c && next[other] == c && c < other) {
+                chosen[c] = -1;
+                jumped[c] = c;
+            } else {
+                jumped[c] = other;
+            }
+        }, 1024);
+
+        // Pointer jumping until every tree points straight at its new root
+        bool moved = true;
+        while (moved) {
+            next.swap(jumped);
+            atomic<bool> changed(false);
+            pool.parallelFor(roots.size(), [&](size_t i, unsigned) {
+                int c = roots[i];
+                int target = next[next[c]];
+                jumped[c] = target;
+                if (target != next[c]) {
+                    changed.store(true, memory_order_relaxed);
+                }
+            }, 1024);
+            moved = changed.load();
+        }
+
+        for (int c : roots) {
+            int e = chosen[c];
+            if (e == -1) continue;
+            chosen[c] = -1;
+            result.edges.push_back({edgeSource[e], graph.targets[e], graph.weights[e]});
+            result.totalDistance += graph.weights[e];
+        }
+        pool.parallelFor(result.nodes.size(), [&](size_t i, unsigned) {
+            int u = result.nodes[i];
+            component[u] = jumped[component[u]];
+        }, 4096);
+        roots.erase(remove_if(roots.begin(), roots.end(),
+                              [&](int c) { return jumped[c] != c; }), roots.end());
+        crossing.erase(remove_if(crossing.begin(), crossing.end(), [&](int e) {
+            return component[edgeSource[e]] == component[graph.targets[e]];
+        }), crossing.end());
+    }
+
+    result.treeCount = static_cast<int>(result.nodes.size() - result.edges.size());
+    return result;
+}
+
+namespace {
+
+// Skew heap of incoming edges; delta is added lazily to the whole subtree
+struct HeapNode {
+    long long weight;
+    int edge;
+    int left = -1;
+    int right = -1;
+    long long delta = 0;
+};
+
+class EdgeHeaps {
+public:
+    explicit EdgeHeaps(size_t capacity) { nodes.reserve(capacity); }
+
+    int make(long long weight, int edge) {
+        nodes.push_back({weight, edge});
+        return static_cast<int>(nodes.size()) - 1;
+    }
+
+    int merge(int a, int b) {
+        if (a == -1 || b == -1) {
+            return a == -1 ? b : a;
+        }
+        push(a);
+        push(b);
+        if (nodes[a].weight > nodes[b].weight) {
+            swap(a, b);
+        }
+        nodes[a].right = merge(b, nodes[a].right);
+        swap(nodes[a].left, nodes[a].right);
+        return a;
+    }
+
+    const HeapNode& top(int heap) {
+        push(heap);
+        return nodes[heap];
+    }
+
+    int pop(int heap) {
+        push(heap);
+        return merge(nodes[heap].left, nodes[heap].right);
+    }
+
+    void add(int heap, long long delta) { nodes[heap].delta += delta; }
+
+private:
+    void push(int heap) {
+        HeapNode& node = nodes[heap];
+        node.weight += node.delta;
+        if (node.left != -1) nodes[node.left].delta += node.delta;
+        if (node.right != -1) nodes[node.right].delta += node.delta;
+        node.delta = 0;
+    }
+
+    vector<HeapNode> nodes;
+};
+
+// Union by size without path compression, so unions can be undone in order
+class RollbackSets {
+public:
+    explicit RollbackSets(int n) : parent(n, -1) {}
+
+    int find(int x) const {
+        while (parent[x] >= 0) x = parent[x];
+        return x;
+    }
+
+    size_t time() const { return history.size(); }
+
+    void rollback(size_t t) {
+        while (history.size() > t) {
+            auto [slot, value] = history.back();
+            history.pop_back();
+            parent[slot] = value;
+        }
+    }
+
+    bool join(int a, int b) {
+        a = find(a);
+        b = find(b);
+        if (a == b) return false;
+        if (parent[a] > parent[b]) swap(a, b);
+        history.emplace_back(a, parent[a]);
+        history.emplace_back(b, parent[b]);
+        parent[a] += parent[b];
+        parent[b] = a;
+        return true;
+    }
+
+private:
+    vector<int> parent;   // Negative size at roots
+    vector<pair<int, int>> history;
+};
+
+}  // namespace
+
+SpanningStructure MinimumSpanning::arborescence(const CompactGraph& graph, int root) {
+    SpanningStructure result;
+    vector<int> reached = Traversal::bfsOrder(graph, root);
+    if (reached.empty()) {
+        return result;
+    }
+    result.nodes = reached;
+    result.treeCount = 1;
+
+    // Work on the reachable part only, renumbered 0..k-1 with the root as 0
+    int k = static_cast<int>(reached.size());
+    vector<int> local(graph.nodeCount(), -1);
+    for (int i = 0; i < k; ++i) {
+        local[reached[i]] = i;
+    }
+
+    EdgeHeaps heaps(graph.edgeCount());
+    vector<int> heap(k, -1);
+    vector<int> edgeFrom;   // Local source of each heap entry's edge, by edge id
+    edgeFrom.assign(graph.edgeCount(), -1);
+    for (int u : reached) {
+        for (int e = graph.offsets[u]; e < graph.offsets[u + 1]; ++e) {
+            int v = local[graph.targets[e]];
+            if (v <= 0) continue;   // Unreached target, or into the root
+            edgeFrom[e] = local[u];
+            heap[v] = heaps.merge(heap[v], heaps.make(graph.weights[e], e));
+        }
+    }
+
+    // Grow paths of cheapest incoming edges, contracting each cycle into one city
+    RollbackSets sets(k);
+    vector<int> seen(k, -1);
+    vector<int> path(k);
+    vector<int> queue(k);
+    vector<int> incoming(k, -1);   // Chosen edge into each (contracted) city
+    struct Contraction {
+        int city;
+        size_t time;
+        vector<int> cycleEdges;
+    };
+    vector<Contraction> contractions;
+    seen[0] = 0;
+
+    for (int start = 0; start < k; ++start) {
+        int u = start;
+        int length = 0;
+        while (seen[u] < 0) {
+            const HeapNode& cheapest = heaps.top(heap[u]);
+            int e = cheapest.edge;
+            long long weight = cheapest.weight;
+            heaps.add(heap[u], -weight);
+            heap[u] = heaps.pop(heap[u]);
+            queue[length] = e;
+            path[length++] = u;
+            seen[u] = start;
+            u = sets.find(edgeFrom[e]);
+
+            if (seen[u] == start) {
+                // Cycle: merge its heaps into one contracted city
+                int merged = -1;
+                int end = length;
+                size_t time = sets.time();
+                int w;
+                do {
+                    w = path[--length];
+                    merged = heaps.merge(merged, heap[w]);
+                } while (sets.join(u, w));
+                u = sets.find(u);
+                heap[u] = merged;
+                seen[u] = -1;
+                contractions.push_back({u, time, vector<int>(queue.begin() + length, queue.begin() + end)});
+            }
+        }
+        for (int i = 0; i < length; ++i) {
+            incoming[sets.find(local[graph.targets[queue[i]]])] = queue[i];
+        }
+    }
+
+    // Expand the cycles again, newest first, keeping all but one edge of each
+    for (auto it = contractions.rbegin(); it != contractions.rend(); ++it) {
+        sets.rollback(it->time);
+        int entry = incoming[it->city];
+        for (int e : it->cycleEdges) {
+            incoming[sets.find(local[graph.targets[e]])] = e;
+        }
+        incoming[sets.find(local[graph.targets[entry]])] = entry;
+    }
+
+    for (int i = 1; i < k; ++i) {
+        int e = incoming[i];
+        result.edges.push_back({reached[edgeFrom[e]], reached[i], graph.weights[e]});
+        result.totalDistance += graph.weights[e];
+    }
+    return result;
+}
@@ -0,0 +1,127 @@
+#include "../include/MultiLevelPartition.hpp"
+#include <algorithm>
+
+using namespace std;
+
+MultiLevelPartition MultiLevelPartition::build(const CompactGraph& graph, vector<int> cellSizes) {
+    if (cellSizes.empty()) {
+        cellSizes = {32, 256, 2048, 16384};
+    }
+    sort(cellSizes.begin(), cellSizes.end());
+
+    // A level with only a handful of huge cells costs more to customize than it saves
+    MultiLevelPartition partition;
+    for (int size : cellSizes) {
+        if (size >= 2 && static_cast<long long>(size) * 8 <= graph.liveCount) {
+            Level level;
+            level.maxCellSize = size;
+            level.cell.assign(graph.nodeCount(), -1);
+            partition.levels.push_back(move(level));
+        }
+    }
+    partition.assignCells(graph);
+    partition.findBoundaries(graph);
+    return partition;
+}
+
+void MultiLevelPartition::assignCells(const CompactGraph& graph) {
+    if (levels.empty()) {
+        return;
+    }
+
+    int n = graph.nodeCount();
+    vector<int> cellCounts(levels.size(), 0);
+    vector<int> inSet(n, -1);       // Id of the set a city currently belongs to
+    vector<char> seen(n, 0);
+    int setId = 0;
+
+    // Undirected BFS inside the current set, starting at start; appends to order
+    auto sweep = [&](int start, vector<int>& order) {
+        size_t head = order.size();
+        seen[start] = 1;
+        order.push_back(start);
+        while (head < order.size()) {
+            int u = order[head++];
+            auto visit = [&](int v) {
+                if (inSet[v] == setId && !seen[v]) {
+                    seen[v] = 1;
+                    order.push_back(v);
+                }
+            };
+            for (int e = graph.offsets[u]; e < graph.offsets[u + 1]; ++e) visit(graph.targets[e]);
+            for (int e = graph.inOffsets[u]; e < graph.inOffsets[u + 1]; ++e) visit(graph.sources[e]);
+        }
+    };
+
+    // Recursive bisection by graph growing; each set that first fits a level becomes a cell there
+    vector<vector<int>> pending(1);
+    for (int u = 0; u < n; ++u) {
+        if (graph.isAlive(u)) pending[0].push_back(u);
+    }
+
+    while (!pending.empty()) {
+        vector<int> cities = move(pending.back());
+        pending.pop_back();
+        if (cities.empty()) continue;
+
+        for (size_t l = 0; l < levels.size(); ++l) {
+            if (static_cast<int>(cities.size()) <= levels[l].maxCellSize && levels[l].cell[cities[0]] == -1) {
+                int cell = cellCounts[l]++;
+                for (int u : cities) levels[l].cell[u] = cell;
+            }
+        }
+        if (static_cast<int>(cities.size()) <= levels[0].maxCellSize) continue;
+
+        // Grow from a far-away city so the first half forms a compact region
+        ++setId;
+        for (int u : cities) inSet[u] = setId;
+        vector<int> order;
+        sweep(cities[0], order);
+        int farthest = order.back();
+        for (int u : order) seen[u] = 0;
+        order.clear();
+        sweep(farthest, order);
+        for (int u : cities) {
+            if (!seen[u]) sweep(u, order);
+        }
+        for (int u : cities) seen[u] = 0;
+
+        size_t half = order.size() / 2;
+        pending.emplace_back(order.begin() + half, order.end());
+        pending.emplace_back(order.begin(), order.begin() + half);
+    }
+}
+
+void MultiLevelPartition::findBoundaries(const CompactGraph& graph) {
+    int n = graph.nodeCount();
+    for (auto& level : levels) {
+        int cells = 0;
+        for (int c : level.cell) cells = max(cells, c + 1);
+        level.entries.assign(cells, {});
+        level.exits.assign(cells, {});
+        level.entryIndex.assign(n, -1);
+        level.exitIndex.assign(n, -1);
+
+        for (int u = 0; u < n; ++u) {
+            for (int e = graph.offsets[u]; e < graph.offsets[u + 1]; ++e) {
+                int v = graph.targets[e];
+                int from = level.cell[u];
+                int to = level.cell[v];
+                if (from == to) continue;
+                if (level.exitIndex[u] == -1) {
+                    level.exitIndex[u] = static_cast<int>(level.exits[from].size());
+                    level.exits[from].push_back(u);
+                }
+                if (level.entryIndex[v] == -1) {
+                    level.entryIndex[v] = static_cast<int>(level.entries[to].size());
+                    level.entries[to].push_back(v);
+                }
+            }
+        }
+
+        level.cliqueOffset.assign(cells + 1, 0);
+        for (int c = 0; c < cells; ++c) {
+            level.cliqueOffset[c + 1] = level.cliqueOffset[c] + level.entries[c].size() * level.exits[c].size();
+        }
+    }
+}
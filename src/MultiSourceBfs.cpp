@@ -0,0 +1,239 @@
+#include "../include/MultiSourceBfs.hpp"
+#include <cstdint>
+#include <memory>
+#include <algorithm>
+
+using namespace std;
+
+namespace {
+
+int lowestBit(uint64_t bits) {
+#if defined(__GNUC__)
+    return __builtin_ctzll(bits);
+#else
+    int bit = 0;
+    while (!(bits & 1)) {
+        bits >>= 1;
+        ++bit;
+    }
+    return bit;
+#endif
+}
+
+// One bit per source of a batch
+template <int Words>
+struct SourceMask {
+    uint64_t bits[Words] = {};
+
+    bool any() const {
+        uint64_t combined = 0;
+        for (int w = 0; w < Words; ++w) combined |= bits[w];
+        return combined != 0;
+    }
+};
+
+// seen/visit/next for one batch; a worker reuses it across batches
+template <int Words>
+struct BatchState {
+    explicit BatchState(int n) : seen(n), visit(n), next(n) {}
+
+    vector<SourceMask<Words>> seen;
+    vector<SourceMask<Words>> visit;
+    vector<SourceMask<Words>> next;
+    vector<int> frontier;
+    vector<int> nextFrontier;
+};
+
+// Runs the BFS of every source in [first, first + count) and calls
+// report(city, mask, hops) once per city and level with the sources that
+// reached the city for the first time at that level
+template <int Words, typename Report>
+void runBatch(const CompactGraph& graph, const vector<int>& sources, size_t first, int count,
+              BatchState<Words>& state, Report report) {
+    state.frontier.clear();
+    for (int i = 0; i < count; ++i) {
+        int source = sources[first + i];
+        if (source < 0 || source >= graph.nodeCount() || !graph.isAlive(source)) continue;
+        uint64_t bit = uint64_t(1) << (i % MultiSourceBfs::WORD_BITS);
+        if (!state.visit[source].any()) {
+            state.frontier.push_back(source);
+        }
+        state.visit[source].bits[i / MultiSourceBfs::WORD_BITS] |= bit;
+        state.seen[source].bits[i / MultiSourceBfs::WORD_BITS] |= bit;
+    }
+    for (int city : state.frontier) {
+        report(city, state.visit[city], 0);
+    }
+
+    for (int hops = 1; !state.frontier.empty(); ++hops) {
+        state.nextFrontier.clear();
+        for (int u : state.frontier) {
+            const SourceMask<Words>& active = state.visit[u];
+            for (int e = graph.offsets[u]; e < graph.offsets[u + 1]; ++e) {
+                int v = graph.targets[e];
+                SourceMask<Words>& pending = state.next[v];
+                const SourceMask<Words>& seen = state.seen[v];
+                bool wasEmpty = !pending.any();
+                uint64_t added = 0;
+                for (int w = 0; w < Words; ++w) {
+                    uint64_t fresh = active.bits[w] & ~seen.bits[w];
+                    pending.bits[w] |= fresh;
+                    added |= fresh;
+                }
+                if (wasEmpty && added) {
+                    state.nextFrontier.push_back(v);
+                }
+            }
+        }
+
+        // Retire this level's frontier and promote the next one
+        for (int u : state.frontier) {
+            state.visit[u] = SourceMask<Words>();
+        }
+        for (int v : state.nextFrontier) {
+            SourceMask<Words>& reached = state.next[v];
+            for (int w = 0; w < Words; ++w) {
+                state.seen[v].bits[w] |= reached.bits[w];
+            }
+            state.visit[v] = reached;
+            reached = SourceMask<Words>();
+            report(v, state.visit[v], hops);
+        }
+        state.frontier.swap(state.nextFrontier);
+    }
+
+    // Leave the state clean for the next batch; seen is the only dirty array
+    for (auto& mask : state.seen) {
+        mask = SourceMask<Words>();
+    }
+}
+
+// Vertical counters: slice j holds bit j of every source's count, so adding
+// a mask is a ripple-carry over a few words instead of a loop over its bits
+template <int Words>
+struct SlicedCounter {
+    vector<SourceMask<Words>> slices;
+
+    void add(const SourceMask<Words>& mask) {
+        SourceMask<Words> carry = mask;
+        for (size_t j = 0; carry.any(); ++j) {
+            if (j == slices.size()) {
+                slices.emplace_back();
+            }
+            for (int w = 0; w < Words; ++w) {
+                uint64_t overflow = slices[j].bits[w] & carry.bits[w];
+                slices[j].bits[w] ^= carry.bits[w];
+                carry.bits[w] = overflow;
+            }
+        }
+    }
+
+    int count(int source) const {
+        int total = 0;
+        uint64_t bit = uint64_t(1) << (source % MultiSourceBfs::WORD_BITS);
+        for (size_t j = 0; j < slices.size(); ++j) {
+            if (slices[j].bits[source / MultiSourceBfs::WORD_BITS] & bit) {
+                total += 1 << j;
+            }
+        }
+        return total;
+    }
+};
+
+// Splits the sources into batches of Words * 64 and runs them on the pool;
+// report(batch, city, mask, hops) sees the batch-relative source bits
+template <int Words, typename Report>
+void forEachBatch(const CompactGraph& graph, const vector<int>& sources, ThreadPool& pool, Report report) {
+    constexpr size_t width = Words * MultiSourceBfs::WORD_BITS;
+    size_t batches = (sources.size() + width - 1) / width;
+    vector<unique_ptr<BatchState<Words>>> states(pool.size());
+    pool.parallelFor(batches, [&](size_t batch, unsigned worker) {
+        if (!states[worker]) {
+            states[worker] = make_unique<BatchState<Words>>(graph.nodeCount());
+        }
+        size_t first = batch * width;
+        int size = static_cast<int>(min(width, sources.size() - first));
+        runBatch<Words>(graph, sources, first, size, *states[worker],
+                        [&](int city, const SourceMask<Words>& mask, int hops) {
+            report(batch, city, mask, hops);
+        });
+    });
+}
+
+template <int Words>
+vector<vector<int>> hopMatrixWith(const CompactGraph& graph, const vector<int>& sources, ThreadPool& pool) {
+    constexpr size_t width = Words * MultiSourceBfs::WORD_BITS;
+    vector<vector<int>> hops(sources.size(), vector<int>(graph.nodeCount(), -1));
+    // Each row belongs to one batch, so workers never share a row
+    forEachBatch<Words>(graph, sources, pool, [&](size_t batch, int city, const SourceMask<Words>& mask, int level) {
+        for (int w = 0; w < Words; ++w) {
+            uint64_t bits = mask.bits[w];
+            while (bits) {
+                int bit = lowestBit(bits);
+                bits &= bits - 1;
+                hops[batch * width + w * MultiSourceBfs::WORD_BITS + bit][city] = level;
+            }
+        }
+    });
+    return hops;
+}
+
+template <int Words>
+vector<vector<int>> hopHistogramWith(const CompactGraph& graph, const vector<int>& sources, ThreadPool& pool) {
+    constexpr size_t width = Words * MultiSourceBfs::WORD_BITS;
+    vector<vector<int>> counts(sources.size());
+
+    // Levels arrive in order, so each batch only counts its current level
+    struct Level {
+        int hops = -1;
+        SlicedCounter<Words> counter;
+    };
+    size_t batches = (sources.size() + width - 1) / width;
+    vector<Level> levels(batches);
+    auto flush = [&](size_t batch) {
+        Level& level = levels[batch];
+        if (level.hops < 0) return;
+        size_t first = batch * width;
+        for (size_t i = first; i < min(first + width, sources.size()); ++i) {
+            int reached = level.counter.count(static_cast<int>(i - first));
+            if (reached > 0) {
+                counts[i].resize(level.hops + 1, 0);
+                counts[i][level.hops] = reached;
+            }
+        }
+        level.counter.slices.clear();
+    };
+
+    forEachBatch<Words>(graph, sources, pool, [&](size_t batch, int, const SourceMask<Words>& mask, int hops) {
+        Level& level = levels[batch];
+        if (hops != level.hops) {
+            flush(batch);
+            level.hops = hops;
+        }
+        level.counter.add(mask);
+    });
+    for (size_t batch = 0; batch < batches; ++batch) {
+        flush(batch);
+    }
+    return counts;
+}
+
+}  // namespace
+
+// Small source sets use a single word per city, which keeps the per-city state small
+
+vector<vector<int>> MultiSourceBfs::hopMatrix(const CompactGraph& graph, const vector<int>& sources,
+                                              ThreadPool& pool) {
+    if (sources.size() <= static_cast<size_t>(WORD_BITS)) {
+        return hopMatrixWith<1>(graph, sources, pool);
+    }
+    return hopMatrixWith<BATCH / WORD_BITS>(graph, sources, pool);
+}
+
+vector<vector<int>> MultiSourceBfs::hopHistogram(const CompactGraph& graph, const vector<int>& sources,
+                                                 ThreadPool& pool) {
+    if (sources.size() <= static_cast<size_t>(WORD_BITS)) {
+        return hopHistogramWith<1>(graph, sources, pool);
+    }
+    return hopHistogramWith<BATCH / WORD_BITS>(graph, sources, pool);
+}
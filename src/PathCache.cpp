@@ -0,0 +1,101 @@
+#include "../include/PathCache.hpp"
+
+using namespace std;
+
+PathCache::PathCache(size_t capacity) : capacity(capacity == 0 ? 1 : capacity) {}
+
+PathCache::PathCache(const PathCache& other) : capacity(other.capacity) {}
+
+PathCache& PathCache::operator=(const PathCache& other) {
+    if (this != &other) {
+        lock_guard<mutex> guard(cacheMutex);
+        capacity = other.capacity;
+        entries.clear();
+        index.clear();
+        hitCount = 0;
+        missCount = 0;
+    }
+    return *this;
+}
+
+bool PathCache::lookup(int source, int target, PathAlgorithm algorithm,
+                       unsigned long version, CachedPath& result) {
+    lock_guard<mutex> guard(cacheMutex);
+
+    auto it = index.find({source, target, algorithm});
+    if (it == index.end()) {
+        missCount++;
+        return false;
+    }
+
+    // An answer computed against another version of the graph is useless
+    if (it->second->version != version) {
+        entries.erase(it->second);
+        index.erase(it);
+        missCount++;
+        return false;
+    }
+
+    // Move to the front so it is evicted last
+    entries.splice(entries.begin(), entries, it->second);
+    result = entries.front();
+    hitCount++;
+    return true;
+}
+
+void PathCache::store(const CachedPath& entry) {
+    lock_guard<mutex> guard(cacheMutex);
+
+    Key key{entry.source, entry.target, entry.algorithm};
+    auto it = index.find(key);
+    if (it != index.end()) {
+        entries.erase(it->second);
+        index.erase(it);
+    }
+
+    entries.push_front(entry);
+    index[key] = entries.begin();
+
+    // Evict the least recently used entries
+    while (entries.size() > capacity) {
+        const CachedPath& oldest = entries.back();
+        index.erase({oldest.source, oldest.target, oldest.algorithm});
+        entries.pop_back();
+    }
+}
+
+void PathCache::advance(unsigned long fromVersion, unsigned long toVersion,
+                        const function<bool(const CachedPath&)>& isStale) {
+    lock_guard<mutex> guard(cacheMutex);
+
+    for (auto it = entries.begin(); it != entries.end();) {
+        if (it->version != fromVersion || isStale(*it)) {
+            index.erase({it->source, it->target, it->algorithm});
+            it = entries.erase(it);
+        } else {
+            it->version = toVersion;
+            ++it;
+        }
+    }
+}
+
+void PathCache::clear() {
+    lock_guard<mutex> guard(cacheMutex);
+    entries.clear();
+    index.clear();
+}
+
+size_t PathCache::hits() const {
+    lock_guard<mutex> guard(cacheMutex);
+    return hitCount;
+}
+
+size_t PathCache::misses() const {
+    lock_guard<mutex> guard(cacheMutex);
+    return missCount;
+}
+
+size_t PathCache::size() const {
+    lock_guard<mutex> guard(cacheMutex);
+    return entries.size();
+}
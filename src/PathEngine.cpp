@@ -0,0 +1,181 @@
+#include "../include/PathEngine.hpp"
+#include "../include/AStar.hpp"
+#include "../include/ArcFlags.hpp"
+#include "../include/SearchWorkspace.hpp"
+#include <climits>
+#include <chrono>
+#include <algorithm>
+
+using namespace std;
+
+PathResult PathEngine::find(const Graph& graph, const string& startCity, const string& endCity,
+                            PathAlgorithm algorithm) {
+    return find(graph, graph.cityId(Graph::standardizeCity(startCity)),
+                graph.cityId(Graph::standardizeCity(endCity)), algorithm);
+}
+
+PathResult PathEngine::find(const Graph& graph, int source, int target, PathAlgorithm algorithm) {
+    auto started = chrono::steady_clock::now();
+    PathResult result;
+    if (source < 0 || target < 0) {
+        return result;
+    }
+
+    // Pairs the reachability labels already separate need no search at all
+    if (!graph.reachability()->mayReach(source, target)) {
+        result.ruledOut = true;
+        result.milliseconds = chrono::duration<double, milli>(chrono::steady_clock::now() - started).count();
+        return result;
+    }
+
+    // Answer repeated queries from the graph's path cache
+    CachedPath cached;
+    if (graph.pathCache().lookup(source, target, algorithm, graph.version(), cached)) {
+        result.distance = cached.distance;
+        result.nodes = move(cached.nodes);
+        result.fromCache = true;
+    } else {
+        auto compact = graph.compact();
+        switch (algorithm) {
+            case PathAlgorithm::Dijkstra:
+                search(*compact, source, target, {}, result);
+                break;
+            case PathAlgorithm::AStar:
+                search(*compact, source, target, AStar::estimatesTo(graph, target), result);
+                break;
+            case PathAlgorithm::ArcFlags:
+                // Goal-directed variant: only relax edges flagged for the target's region
+                result.distance = graph.arcFlags()->shortestPath(*compact, source, target,
+                                                                 result.nodes, &result.settled);
+                break;
+            case PathAlgorithm::Crp:
+                // Multi-level overlay, customized for the current distances on first use
+                result.distance = graph.customizedRoutes()->shortestPath(*compact, source, target,
+                                                                         result.nodes, &result.settled);
+                break;
+        }
+
+        CachedPath entry;
+        entry.source = source;
+        entry.target = target;
+        entry.algorithm = algorithm;
+        entry.version = graph.version();
+        entry.distance = result.distance;
+        entry.nodes = result.nodes;
+        graph.pathCache().store(entry);
+    }
+
+    result.milliseconds = chrono::duration<double, milli>(chrono::steady_clock::now() - started).count();
+    return result;
+}
+
+void PathEngine::search(const CompactGraph& graph, int source, int target,
+                        const vector<int>& heuristic, PathResult& result) {
+    int n = graph.nodeCount();
+    if (source >= n || target >= n || !graph.isAlive(source) || !graph.isAlive(target)) {
+        return;
+    }
+
+    // Queue entries are (distance + estimate, node); without an estimate this is Dijkstra
+    auto estimate = [&](int node) { return heuristic.empty() ? 0 : heuristic[node]; };
+    SearchWorkspace& ws = SearchWorkspace::local();
+    ws.begin(n);
+    ws.set(source, 0, -1);
+    ws.push(estimate(source), source);
+
+    while (!ws.empty()) {
+        auto [key, u] = ws.pop();
+        int du = ws.distance(u);
+        // Stale entry; an inconsistent estimate may legitimately reopen a city
+        if (key > du + estimate(u)) continue;
+        result.settled++;
+        if (u == target) break;
+
+        for (int e = graph.offsets[u]; e < graph.offsets[u + 1]; ++e) {
+            int v = graph.targets[e];
+            int nd = du + graph.weights[e];
+            if (nd < ws.distance(v)) {
+                ws.set(v, nd, u);
+                ws.push(nd + estimate(v), v);
+            }
+        }
+    }
+
+    if (ws.distance(target) == INT_MAX) {
+        return;
+    }
+    result.distance = ws.distance(target);
+    for (int v = target; v != -1; v = ws.parentOf(v)) {
+        result.nodes.push_back(v);
+    }
+    reverse(result.nodes.begin(), result.nodes.end());
+}
+
+PathResult PathEngine::dijkstra(const CompactGraph& graph, int source, int target) {
+    PathResult result;
+    if (source >= 0 && target >= 0) {
+        search(graph, source, target, {}, result);
+    }
+    return result;
+}
+
+void PathEngine::shortestPathTree(const CompactGraph& graph, int source,
+                                  vector<int>& distance, vector<int>& parent) {
+    int n = graph.nodeCount();
+    distance.assign(n, INT_MAX);
+    parent.assign(n, -1);
+    if (source < 0 || source >= n || !graph.isAlive(source)) {
+        return;
+    }
+
+    // The point-to-point search without a target, copied out of the workspace
+    SearchWorkspace& ws = SearchWorkspace::local();
+    ws.begin(n);
+    ws.set(source, 0, -1);
+    ws.push(0, source);
+    while (!ws.empty()) {
+        auto [du, u] = ws.pop();
+        if (du > ws.distance(u)) continue;
+        for (int e = graph.offsets[u]; e < graph.offsets[u + 1]; ++e) {
+            int v = graph.targets[e];
+            int nd = du + graph.weights[e];
+            if (nd < ws.distance(v)) {
+                ws.set(v, nd, u);
+                ws.push(nd, v);
+            }
+        }
+    }
+    for (int v : ws.reachedNodes()) {
+        distance[v] = ws.distance(v);
+        parent[v] = ws.parentOf(v);
+    }
+}
+
+vector<string> PathEngine::cityNames(const Graph& graph, const PathResult& result) {
+    vector<string> names;
+    names.reserve(result.nodes.size());
+    for (int id : result.nodes) {
+        names.push_back(graph.cityName(id));
+    }
+    return names;
+}
+
+string PathEngine::formatPath(const Graph& graph, const vector<int>& nodes, const string& separator) {
+    string text;
+    for (size_t i = 0; i < nodes.size(); ++i) {
+        if (i > 0) {
+            text += separator;
+        }
+        text += graph.cityName(nodes[i]);
+    }
+    return text;
+}
+
+string PathEngine::algorithmName(PathAlgorithm algorithm) {
+    switch (algorithm) {
+        case PathAlgorithm::AStar: return "A*";
+        case PathAlgorithm::ArcFlags: return "Dijkstra (arc-flags)";
+        case PathAlgorithm::Crp: return "Customizable route planning";
+        default: return "Dijkstra";
+    }
+}
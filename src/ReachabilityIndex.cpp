@@ -0,0 +1,140 @@
+#include "../include/ReachabilityIndex.hpp"
+#include <algorithm>
+#include <climits>
+#include <numeric>
+#include <random>
+
+using namespace std;
+
+ReachabilityIndex ReachabilityIndex::build(shared_ptr<const StrongComponents> components) {
+    ReachabilityIndex index;
+    int count = components->componentCount();
+    const vector<int>& offsets = components->dagOffsets;
+    const vector<int>& targets = components->dagTargets;
+    index.low.assign(static_cast<size_t>(count) * LABELINGS, 0);
+    index.rank.assign(static_cast<size_t>(count) * LABELINGS, 0);
+
+    mt19937 random(1);
+    vector<int> roots(count);
+    vector<int> firstChild(count);
+    vector<char> visited(count);
+    vector<pair<int, int>> calls;   // (component, children still to visit)
+
+    for (int pass = 0; pass < LABELINGS; ++pass) {
+        // Each pass starts from the components in a different order and
+        // walks every component's children from a different offset
+        iota(roots.begin(), roots.end(), 0);
+        if (pass == 0) {
+            reverse(roots.begin(), roots.end());   // Topological order
+        } else {
+            shuffle(roots.begin(), roots.end(), random);
+        }
+        for (int c = 0; c < count; ++c) {
+            int degree = offsets[c + 1] - offsets[c];
+            firstChild[c] = degree > 0 ? static_cast<int>(random() % degree) : 0;
+        }
+        fill(visited.begin(), visited.end(), 0);
+        int nextRank = 0;
+
+        for (int root : roots) {
+            if (visited[root]) continue;
+            visited[root] = 1;
+            index.low[static_cast<size_t>(root) * LABELINGS + pass] = INT_MAX;
+            calls.emplace_back(root, offsets[root + 1] - offsets[root]);
+
+            while (!calls.empty()) {
+                auto& [c, remaining] = calls.back();
+                size_t slot = static_cast<size_t>(c) * LABELINGS + pass;
+                if (remaining > 0) {
+                    int degree = offsets[c + 1] - offsets[c];
+                    int child = targets[offsets[c] + (firstChild[c] + --remaining) % degree];
+                    size_t childSlot = static_cast<size_t>(child) * LABELINGS + pass;
+                    if (!visited[child]) {
+                        visited[child] = 1;
+                        index.low[childSlot] = INT_MAX;
+                        calls.emplace_back(child, offsets[child + 1] - offsets[child]);
+                    } else {
+                        // A finished descendant; the DAG has no edges back up the stack
+                        index.low[slot] = min(index.low[slot], index.low[childSlot]);
+                    }
+                    continue;
+                }
+
+                index.rank[slot] = nextRank++;
+                index.low[slot] = min(index.low[slot], index.rank[slot]);
+                int finishedLow = index.low[slot];
+                calls.pop_back();
+                if (!calls.empty()) {
+                    size_t parentSlot = static_cast<size_t>(calls.back().first) * LABELINGS + pass;
+                    index.low[parentSlot] = min(index.low[parentSlot], finishedLow);
+                }
+            }
+        }
+    }
+
+    index.components = move(components);
+    return index;
+}
+
+bool ReachabilityIndex::nests(int from, int to) const {
+    const int* fromLow = &low[static_cast<size_t>(from) * LABELINGS];
+    const int* fromRank = &rank[static_cast<size_t>(from) * LABELINGS];
+    const int* toLow = &low[static_cast<size_t>(to) * LABELINGS];
+    const int* toRank = &rank[static_cast<size_t>(to) * LABELINGS];
+    for (int pass = 0; pass < LABELINGS; ++pass) {
+        if (toLow[pass] < fromLow[pass] || toRank[pass] > fromRank[pass]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool ReachabilityIndex::mayReach(int source, int target) const {
+    if (!components->mayReach(source, target)) {
+        return false;
+    }
+    return nests(components->componentOf(source), components->componentOf(target));
+}
+
+bool ReachabilityIndex::reaches(int source, int target) const {
+    if (!mayReach(source, target)) {
+        return false;
+    }
+    int from = components->componentOf(source);
+    int to = components->componentOf(target);
+    if (from == to) {
+        return true;
+    }
+
+    // Pruned DFS; visit marks are stamped per query so nothing is cleared
+    thread_local vector<unsigned> seen;
+    thread_local unsigned stamp = 0;
+    if (seen.size() < static_cast<size_t>(components->componentCount())) {
+        seen.assign(components->componentCount(), 0);
+        stamp = 0;
+    }
+    if (++stamp == 0) {
+        fill(seen.begin(), seen.end(), 0);
+        stamp = 1;
+    }
+
+    const vector<int>& offsets = components->dagOffsets;
+    const vector<int>& targets = components->dagTargets;
+    vector<int> pending{from};
+    seen[from] = stamp;
+    while (!pending.empty()) {
+        int c = pending.back();
+        pending.pop_back();
+        for (int e = offsets[c]; e < offsets[c + 1]; ++e) {
+            int child = targets[e];
+            if (child == to) {
+                return true;
+            }
+            // DAG edges lower the id, so nothing at or below the target's id can lead to it
+            if (child < to || seen[child] == stamp || !nests(child, to)) continue;
+            seen[child] = stamp;
+            pending.push_back(child);
+        }
+    }
+    return false;
+}
@@ -0,0 +1,120 @@
+#include "../include/ServiceRegions.hpp"
+#include <iostream>
+#include <sstream>
+#include <limits>
+#include <queue>
+#include <tuple>
+
+using namespace std;
+
+ServiceAssignment ServiceRegions::assign(const CompactGraph& graph, const vector<Facility>& facilities) {
+    int n = graph.nodeCount();
+    ServiceAssignment result;
+    result.nearest.assign(n, -1);
+    result.distance.assign(n, INT_MAX);
+
+    // Queue entries are (distance, facility, city) so ties settle deterministically
+    typedef tuple<int, int, int> Label;
+    priority_queue<Label, vector<Label>, greater<Label>> pq;
+    auto better = [&](int dist, int facility, int city) {
+        return dist < result.distance[city] ||
+               (dist == result.distance[city] && facility < result.nearest[city]);
+    };
+
+    for (size_t i = 0; i < facilities.size(); ++i) {
+        int city = facilities[i].city;
+        if (city < 0 || city >= n || !graph.isAlive(city)) continue;
+        int facility = static_cast<int>(i);
+        if (better(facilities[i].offset, facility, city)) {
+            result.distance[city] = facilities[i].offset;
+            result.nearest[city] = facility;
+            pq.push({facilities[i].offset, facility, city});
+        }
+    }
+
+    while (!pq.empty()) {
+        auto [d, facility, u] = pq.top();
+        pq.pop();
+        if (d != result.distance[u] || facility != result.nearest[u]) continue;
+
+        for (int e = graph.offsets[u]; e < graph.offsets[u + 1]; ++e) {
+            int v = graph.targets[e];
+            int nd = d + graph.weights[e];
+            if (better(nd, facility, v)) {
+                result.distance[v] = nd;
+                result.nearest[v] = facility;
+                pq.push({nd, facility, v});
+            }
+        }
+    }
+    return result;
+}
+
+ServiceAssignment ServiceRegions::assign(const Graph& graph, const vector<string>& facilityCities) {
+    vector<Facility> facilities;
+    for (const auto& city : facilityCities) {
+        facilities.push_back({graph.cityId(Graph::standardizeCity(city)), 0});
+    }
+    return assign(*graph.compact(), facilities);
+}
+
+void ServiceRegions::findNearest(Graph& graph) {
+    cout << "Enter facility cities separated by spaces, optionally as CITY:OFFSET\n";
+    cout << "(e.g. Khartoum Bahri:5), or 'back' to return to main menu: ";
+    cin.ignore(numeric_limits<streamsize>::max(), '\n');
+    string line;
+    getline(cin, line);
+    if (line == "back" || line == "BACK" || line == "Back") {
+        return;
+    }
+
+    istringstream iss(line);
+    vector<Facility> facilities;
+    vector<string> names;
+    string token;
+    while (iss >> token) {
+        Facility facility;
+        size_t colon = token.find(':');
+        string city = Graph::standardizeCity(token.substr(0, colon));
+        if (colon != string::npos) {
+            try {
+                facility.offset = stoi(token.substr(colon + 1));
+            } catch (...) {
+                cout << "Invalid offset in " << token << ", using 0.\n";
+            }
+        }
+        facility.city = graph.cityId(city);
+        if (facility.city < 0) {
+            cout << "City " << city << " not found in the graph, skipping.\n";
+            continue;
+        }
+        facilities.push_back(facility);
+        names.push_back(city);
+    }
+    if (facilities.empty()) {
+        cout << "No valid facilities given.\n";
+        return;
+    }
+
+    ServiceAssignment assignment = assign(*graph.compact(), facilities);
+    vector<vector<int>> regions(facilities.size());
+    vector<int> unserved;
+    for (int city = 0; city < static_cast<int>(assignment.nearest.size()); ++city) {
+        if (!graph.compact()->isAlive(city)) continue;
+        if (assignment.nearest[city] < 0) {
+            unserved.push_back(city);
+        } else {
+            regions[assignment.nearest[city]].push_back(city);
+        }
+    }
+
+    for (size_t i = 0; i < facilities.size(); ++i) {
+        cout << "\nServed by " << names[i] << " (" << regions[i].size() << " cities):\n";
+        for (int city : regions[i]) {
+            cout << "  " << graph.cityName(city) << " (" << assignment.distance[city] << ")\n";
+        }
+    }
+    if (!unserved.empty()) {
+        cout << "\nNot reachable from any facility: " << unserved.size() << " cities\n";
+    }
+}
@@ -0,0 +1,268 @@
+#include "../include/ShortestPathTree.hpp"
+#include "../include/PathEngine.hpp"
+#include <queue>
+#include <algorithm>
+
+using namespace std;
+
+typedef priority_queue<pair<int, int>, vector<pair<int, int>>, greater<pair<int, int>>> CityQueue;
+
+ShortestPathTree::ShortestPathTree(Graph& graph, const string& sourceCity)
+    : graph(graph), sourceCity(Graph::standardizeCity(sourceCity)) {
+    graph.addObserver(this);
+    rebuild();
+}
+
+ShortestPathTree::~ShortestPathTree() {
+    graph.removeObserver(this);
+}
+
+void ShortestPathTree::rebuild() {
+    sourceId = graph.cityId(sourceCity);
+    valid = sourceId >= 0;
+    if (!valid) {
+        reset();
+        return;
+    }
+
+    // Plain Dijkstra over the whole reachable part of the graph, from the engine
+    PathEngine::shortestPathTree(*graph.compact(), sourceId, dist, parent);
+    children.assign(dist.size(), {});
+    affected.assign(dist.size(), 0);
+    repaired = 0;
+    for (int city = 0; city < static_cast<int>(dist.size()); ++city) {
+        if (dist[city] == UNREACHED) continue;
+        repaired++;
+        if (parent[city] >= 0) {
+            children[parent[city]].push_back(city);
+        }
+    }
+}
+
+void ShortestPathTree::reset() {
+    sourceId = -1;
+    repaired = 0;
+    dist.clear();
+    parent.clear();
+    children.clear();
+    affected.clear();
+}
+
+void ShortestPathTree::ensureSlot(int city) {
+    if (city >= static_cast<int>(dist.size())) {
+        dist.resize(city + 1, UNREACHED);
+        parent.resize(city + 1, -1);
+        children.resize(city + 1);
+        affected.resize(city + 1, 0);
+    }
+}
+
+vector<pair<int, int>> ShortestPathTree::connections(int city, bool outgoing) const {
+    const auto& lists = outgoing ? graph.getAdjList() : graph.getInAdjList();
+    vector<pair<int, int>> result;
+    for (const auto& [name, distance] : lists.at(graph.cityName(city))) {
+        result.push_back({graph.cityId(name), distance});
+    }
+    return result;
+}
+
+void ShortestPathTree::setParent(int city, int parentCity) {
+    if (parent[city] >= 0) {
+        auto& siblings = children[parent[city]];
+        siblings.erase(find(siblings.begin(), siblings.end(), city));
+    }
+    parent[city] = parentCity;
+    children[parentCity].push_back(city);
+}
+
+void ShortestPathTree::detach(int city) {
+    if (parent[city] >= 0) {
+        auto& siblings = children[parent[city]];
+        auto it = find(siblings.begin(), siblings.end(), city);
+        if (it != siblings.end()) {
+            siblings.erase(it);
+        }
+        parent[city] = -1;
+    }
+    dist[city] = UNREACHED;
+}
+
+int ShortestPathTree::distanceTo(const string& city) const {
+    int id = graph.cityId(city);
+    return valid && reached(id) ? dist[id] : -1;
+}
+
+vector<int> ShortestPathTree::pathTo(const string& city) const {
+    vector<int> path;
+    int id = graph.cityId(city);
+    if (!valid || !reached(id)) {
+        return path;
+    }
+
+    for (int current = id; current != -1; current = parent[current]) {
+        path.push_back(current);
+    }
+    reverse(path.begin(), path.end());
+    return path;
+}
+
+void ShortestPathTree::improve(int from, int to, int distance) {
+    repaired = 0;
+    if (!valid || !reached(from)) {
+        return;  // The new edge starts outside the tree
+    }
+
+    int newDist = dist[from] + distance;
+    if (newDist >= dist[to]) {
+        return;  // Not a shortcut
+    }
+
+    // Propagate the improvement; only cities that get closer are visited
+    CityQueue pq;
+    dist[to] = newDist;
+    setParent(to, from);
+    pq.push({newDist, to});
+
+    while (!pq.empty()) {
+        auto [d, current] = pq.top();
+        pq.pop();
+        if (d > dist[current]) continue;
+        repaired++;
+
+        for (const auto& [neighbor, weight] : connections(current, true)) {
+            int candidate = d + weight;
+            if (candidate < dist[neighbor]) {
+                dist[neighbor] = candidate;
+                setParent(neighbor, current);
+                pq.push({candidate, neighbor});
+            }
+        }
+    }
+}
+
+void ShortestPathTree::repairSubtrees(const vector<int>& roots) {
+    // Collect every city whose tree path ran through one of the roots
+    vector<int> cities;
+    vector<int> pending;
+    for (int root : roots) {
+        if (reached(root) && !affected[root]) {
+            affected[root] = 1;
+            pending.push_back(root);
+        }
+    }
+    while (!pending.empty()) {
+        int current = pending.back();
+        pending.pop_back();
+        cities.push_back(current);
+        for (int child : children[current]) {
+            if (!affected[child]) {
+                affected[child] = 1;
+                pending.push_back(child);
+            }
+        }
+    }
+
+    for (int city : cities) {
+        detach(city);
+    }
+    for (int city : cities) {
+        children[city].clear();
+    }
+
+    // Seed each affected city with its best edge from the unaffected part
+    CityQueue pq;
+    for (int city : cities) {
+        int best = UNREACHED;
+        int bestParent = -1;
+        for (const auto& [from, weight] : connections(city, false)) {
+            if (affected[from] || !reached(from)) continue;
+            if (dist[from] + weight < best) {
+                best = dist[from] + weight;
+                bestParent = from;
+            }
+        }
+        if (bestParent >= 0) {
+            dist[city] = best;
+            setParent(city, bestParent);
+            pq.push({best, city});
+        }
+    }
+
+    // Dijkstra restricted to the affected cities; nothing else can change
+    while (!pq.empty()) {
+        auto [d, current] = pq.top();
+        pq.pop();
+        if (d > dist[current]) continue;
+
+        for (const auto& [neighbor, weight] : connections(current, true)) {
+            if (!affected[neighbor]) continue;
+            int candidate = d + weight;
+            if (candidate < dist[neighbor]) {
+                dist[neighbor] = candidate;
+                setParent(neighbor, current);
+                pq.push({candidate, neighbor});
+            }
+        }
+    }
+
+    for (int city : cities) {
+        affected[city] = 0;
+    }
+    repaired = cities.size();
+}
+
+void ShortestPathTree::onEdgeAdded(const string& from, const string& to, int distance) {
+    int fromId = graph.cityId(from);
+    int toId = graph.cityId(to);
+    ensureSlot(max(fromId, toId));
+    improve(fromId, toId, distance);
+}
+
+void ShortestPathTree::onEdgeRemoved(const string& from, const string& to, int) {
+    repaired = 0;
+    int fromId = graph.cityId(from);
+    int toId = graph.cityId(to);
+    if (valid && reached(toId) && parent[toId] == fromId) {
+        repairSubtrees({toId});
+    }
+}
+
+void ShortestPathTree::onEdgeWeightChanged(const string& from, const string& to, int oldDistance, int newDistance) {
+    int fromId = graph.cityId(from);
+    int toId = graph.cityId(to);
+    ensureSlot(max(fromId, toId));
+    if (newDistance < oldDistance) {
+        improve(fromId, toId, newDistance);
+        return;
+    }
+    repaired = 0;
+    if (valid && reached(toId) && parent[toId] == fromId) {
+        repairSubtrees({toId});
+    }
+}
+
+void ShortestPathTree::onCityRemoved(const string&, int id) {
+    repaired = 0;
+    if (id == sourceId) {
+        valid = false;
+        reset();
+        return;
+    }
+    if (!valid || !reached(id)) {
+        return;
+    }
+
+    // Everything hanging below the city needs another way in
+    vector<int> orphans = children[id];
+    detach(id);
+    children[id].clear();
+    for (int orphan : orphans) {
+        parent[orphan] = -1;
+    }
+    repairSubtrees(orphans);
+}
+
+void ShortestPathTree::onGraphCleared() {
+    valid = false;
+    reset();
+}
@@ -0,0 +1,129 @@
+#include "../include/StrongComponents.hpp"
+#include <algorithm>
+
+using namespace std;
+
+StrongComponents StrongComponents::build(const CompactGraph& graph) {
+    int n = graph.nodeCount();
+    StrongComponents result;
+    result.component.assign(n, -1);
+
+    // Tarjan with an explicit call stack of (city, next edge) frames
+    vector<int> index(n, -1);
+    vector<int> low(n, 0);
+    vector<char> onStack(n, 0);
+    vector<int> members;
+    vector<pair<int, int>> calls;
+    int nextIndex = 0;
+
+    for (int root = 0; root < n; ++root) {
+        if (!graph.isAlive(root) || index[root] != -1) continue;
+
+        index[root] = low[root] = nextIndex++;
+        members.push_back(root);
+        onStack[root] = 1;
+        calls.emplace_back(root, graph.offsets[root]);
+
+        while (!calls.empty()) {
+            auto& [u, edge] = calls.back();
+            if (edge < graph.offsets[u + 1]) {
+                int v = graph.targets[edge++];
+                if (index[v] == -1) {
+                    index[v] = low[v] = nextIndex++;
+                    members.push_back(v);
+                    onStack[v] = 1;
+                    calls.emplace_back(v, graph.offsets[v]);
+                } else if (onStack[v]) {
+                    low[u] = min(low[u], index[v]);
+                }
+                continue;
+            }
+
+            // u is finished; pop its component if it is the root of one
+            int finished = u;
+            calls.pop_back();
+            if (low[finished] == index[finished]) {
+                int id = static_cast<int>(result.sizes.size());
+                int size = 0;
+                int member;
+                do {
+                    member = members.back();
+                    members.pop_back();
+                    onStack[member] = 0;
+                    result.component[member] = id;
+                    size++;
+                } while (member != finished);
+                result.sizes.push_back(size);
+            }
+            if (!calls.empty()) {
+                int parent = calls.back().first;
+                low[parent] = min(low[parent], low[finished]);
+            }
+        }
+    }
+
+    int count = result.componentCount();
+    for (int c = 0; c < count; ++c) {
+        if (result.largest == -1 || result.sizes[c] > result.sizes[result.largest]) {
+            result.largest = c;
+        }
+    }
+
+    // Condensation edges, bucketed by source component and deduplicated
+    vector<int> lastSeen(count, -1);
+    vector<vector<int>> buckets(count);
+    for (int u = 0; u < n; ++u) {
+        if (!graph.isAlive(u)) continue;
+        int from = result.component[u];
+        for (int e = graph.offsets[u]; e < graph.offsets[u + 1]; ++e) {
+            int to = result.component[graph.targets[e]];
+            if (to != from) {
+                buckets[from].push_back(to);
+            }
+        }
+    }
+    result.dagOffsets.assign(count + 1, 0);
+    for (int c = 0; c < count; ++c) {
+        result.dagOffsets[c] = static_cast<int>(result.dagTargets.size());
+        for (int to : buckets[c]) {
+            if (lastSeen[to] != c) {
+                lastSeen[to] = c;
+                result.dagTargets.push_back(to);
+            }
+        }
+    }
+    result.dagOffsets[count] = static_cast<int>(result.dagTargets.size());
+
+    // Ids are a reverse topological order: sinks first, sources last
+    result.depth.assign(count, 0);
+    result.height.assign(count, 0);
+    for (int c = 0; c < count; ++c) {
+        for (int e = result.dagOffsets[c]; e < result.dagOffsets[c + 1]; ++e) {
+            result.height[c] = max(result.height[c], result.height[result.dagTargets[e]] + 1);
+        }
+    }
+    for (int c = count - 1; c >= 0; --c) {
+        for (int e = result.dagOffsets[c]; e < result.dagOffsets[c + 1]; ++e) {
+            int to = result.dagTargets[e];
+            result.depth[to] = max(result.depth[to], result.depth[c] + 1);
+        }
+    }
+    return result;
+}
+
+bool StrongComponents::mayReach(int source, int target) const {
+    if (source < 0 || target < 0 || source >= static_cast<int>(component.size()) ||
+        target >= static_cast<int>(component.size())) {
+        return false;
+    }
+    int from = component[source];
+    int to = component[target];
+    if (from == -1 || to == -1) {
+        return false;
+    }
+    if (from == to) {
+        return true;
+    }
+    // Every DAG edge lowers the id, raises depth and lowers height
+    return to < from && depth[to] > depth[from] && height[to] < height[from];
+}
@@ -0,0 +1,95 @@
+#include "../include/ThreadPool.hpp"
+#include <algorithm>
+
+using namespace std;
+
+ThreadPool::ThreadPool(unsigned threadCount) {
+    if (threadCount == 0) {
+        threadCount = 1;
+    }
+    for (unsigned i = 0; i < threadCount; ++i) {
+        workers.emplace_back(&ThreadPool::workerLoop, this, i);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        lock_guard<mutex> guard(poolMutex);
+        stopping = true;
+    }
+    wakeUp.notify_all();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+ThreadPool& ThreadPool::shared() {
+    static ThreadPool pool;
+    return pool;
+}
+
+void ThreadPool::parallelFor(size_t count, const function<void(size_t, unsigned)>& task, size_t grain) {
+    if (count == 0) {
+        return;
+    }
+
+    // Not worth waking anyone for a single block
+    if (workers.size() == 1 || count <= grain) {
+        for (size_t i = 0; i < count; ++i) {
+            task(i, 0);
+        }
+        return;
+    }
+
+    lock_guard<mutex> caller(callerMutex);
+    unique_lock<mutex> lock(poolMutex);
+    job = &task;
+    jobCount = count;
+    jobGrain = max<size_t>(1, grain);
+    nextIndex.store(0);
+    busyWorkers = size();
+    jobGeneration++;
+    wakeUp.notify_all();
+
+    jobDone.wait(lock, [this]() { return busyWorkers == 0; });
+    job = nullptr;
+}
+
+void ThreadPool::workerLoop(unsigned worker) {
+    unsigned long seenGeneration = 0;
+
+    while (true) {
+        const function<void(size_t, unsigned)>* task;
+        size_t count, grain;
+        {
+            unique_lock<mutex> lock(poolMutex);
+            wakeUp.wait(lock, [&]() { return stopping || jobGeneration != seenGeneration; });
+            if (stopping) {
+                return;
+            }
+            seenGeneration = jobGeneration;
+            task = job;
+            count = jobCount;
+            grain = jobGrain;
+        }
+
+        // Claim blocks of indices until the range is exhausted
+        while (true) {
+            size_t begin = nextIndex.fetch_add(grain);
+            if (begin >= count) {
+                break;
+            }
+            size_t end = min(count, begin + grain);
+            for (size_t i = begin; i < end; ++i) {
+                (*task)(i, worker);
+            }
+        }
+
+        {
+            lock_guard<mutex> guard(poolMutex);
+            if (--busyWorkers == 0) {
+                jobDone.notify_all();
+            }
+        }
+    }
+}
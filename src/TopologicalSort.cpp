@@ -0,0 +1,102 @@
+#include "../include/TopologicalSort.hpp"
+#include <algorithm>
+
+using namespace std;
+
+Layering TopologicalSort::layers(const CompactGraph& graph) {
+    return layers(graph.nodeCount(), graph.offsets, graph.targets, graph.alive);
+}
+
+Layering TopologicalSort::layers(const vector<vector<int>>& successors) {
+    int n = static_cast<int>(successors.size());
+    vector<int> offsets(n + 1, 0);
+    vector<int> targets;
+    for (int u = 0; u < n; ++u) {
+        offsets[u] = static_cast<int>(targets.size());
+        targets.insert(targets.end(), successors[u].begin(), successors[u].end());
+    }
+    offsets[n] = static_cast<int>(targets.size());
+    return layers(n, offsets, targets, vector<char>(n, 1));
+}
+
+Layering TopologicalSort::layers(int n, const vector<int>& offsets, const vector<int>& targets,
+                                 const vector<char>& alive) {
+    Layering result;
+    result.layer.assign(n, -1);
+
+    // Incoming edges, to name the feedback arcs of a node taken out of a cycle
+    vector<int> remaining(n, 0);
+    vector<int> inOffsets(n + 1, 0);
+    for (int u = 0; u < n; ++u) {
+        if (!alive[u]) continue;
+        for (int e = offsets[u]; e < offsets[u + 1]; ++e) {
+            remaining[targets[e]]++;
+            inOffsets[targets[e] + 1]++;
+        }
+    }
+    for (int v = 0; v < n; ++v) {
+        inOffsets[v + 1] += inOffsets[v];
+    }
+    vector<int> sources(inOffsets[n]);
+    vector<int> fill(inOffsets.begin(), inOffsets.end() - 1);
+    for (int u = 0; u < n; ++u) {
+        if (!alive[u]) continue;
+        for (int e = offsets[u]; e < offsets[u + 1]; ++e) {
+            sources[fill[targets[e]]++] = u;
+        }
+    }
+
+    // Bucket queue keyed by remaining in-degree. Degrees only fall, so a node
+    // is re-filed at most once per incoming edge and stale entries are skipped.
+    vector<vector<int>> buckets;
+    auto file = [&](int v) {
+        if (remaining[v] >= static_cast<int>(buckets.size())) {
+            buckets.resize(remaining[v] + 1);
+        }
+        buckets[remaining[v]].push_back(v);
+    };
+    vector<char> done(n, 0);
+    int liveCount = 0;
+    for (int v = n - 1; v >= 0; --v) {
+        if (alive[v]) {
+            file(v);
+            liveCount++;
+        }
+    }
+    vector<int> layer(n, 0);
+    size_t lowest = 0;
+
+    while (static_cast<int>(result.order.size()) < liveCount) {
+        while (lowest < buckets.size() && buckets[lowest].empty()) {
+            lowest++;
+        }
+        int v = buckets[lowest].back();
+        buckets[lowest].pop_back();
+        if (done[v] || remaining[v] != static_cast<int>(lowest)) {
+            continue;
+        }
+
+        // Anything still pointing at v lies on a cycle through it
+        if (remaining[v] > 0) {
+            for (int e = inOffsets[v]; e < inOffsets[v + 1]; ++e) {
+                if (!done[sources[e]]) {
+                    result.feedbackArcs.emplace_back(sources[e], v);
+                }
+            }
+        }
+        done[v] = 1;
+        result.order.push_back(v);
+        result.layer[v] = layer[v];
+        result.layerCount = max(result.layerCount, layer[v] + 1);
+
+        for (int e = offsets[v]; e < offsets[v + 1]; ++e) {
+            int w = targets[e];
+            if (done[w]) continue;   // Self-loop, already reported as a feedback arc
+            layer[w] = max(layer[w], layer[v] + 1);
+            remaining[w]--;
+            file(w);
+            lowest = min(lowest, static_cast<size_t>(remaining[w]));
+        }
+    }
+    return result;
+}
@@ -1,6 +1,13 @@
 #include "../include/Traversal.hpp"
+#include "../include/NodeBitset.hpp"
 #include <iostream>
 #include <limits>
+#include <algorithm>
+#include <atomic>
+#include <climits>
+
+// Frontiers narrower than this are not worth splitting across threads
+static const size_t PARALLEL_LEVEL_WIDTH = 1024;
 
 using namespace std;
 
@@ -11,8 +18,9 @@ void Traversal::traverse(Graph& graph) {
     cout << "\n=== Traversal Options ===\n";
     cout << "1. Depth First Search (DFS)\n";
     cout << "2. Breadth First Search (BFS)\n";
-    cout << "3. Back to Main Menu\n";
-    cout << "Select traversal type (1-3): ";
+    cout << "3. Hop Distances (direction-optimizing BFS)\n";
+    cout << "4. Back to Main Menu\n";
+    cout << "Select traversal type (1-4): ";
     cin >> input;
     
     if (cin.fail()) {
@@ -23,7 +31,7 @@ void Traversal::traverse(Graph& graph) {
     }
     
     // Check if input is "back"
-    if (input == "back" || input == "BACK" || input == "Back" || input == "3") {
+    if (input == "back" || input == "BACK" || input == "Back" || input == "4") {
         return;
     }
     
@@ -35,7 +43,7 @@ void Traversal::traverse(Graph& graph) {
         return;
     }
     
-    if (choice < 1 || choice > 2) {
+    if (choice < 1 || choice > 3) {
         cout << "Invalid choice. Returning to main menu.\n";
         return;
     }
@@ -68,167 +76,418 @@ void Traversal::traverse(Graph& graph) {
             break;
         case 2:
             bfs(graph, startCity);
-
-            bfs(graph, startCity);
-
+            break;
+        case 3:
+            showHopDistances(graph, startCity);
             break;
         default:
-            cout << "Invalid choice. Please select 1 or 2.\n";
+            cout << "Invalid choice. Please select 1, 2 or 3.\n";
     }
 }
 
 void Traversal::dfs(Graph& graph, const string& startCity) {
-    // Get the adjacency list from the graph
-    const auto& adjList = graph.getAdjList();
-    string standardCity = Graph::standardizeCity(startCity);
-    
-    if (adjList.find(standardCity) == adjList.end()) {
+    int source = graph.cityId(startCity);
+    if (source < 0) {
         cout << "Start city not found in the graph.\n";
         return;
     }
 
-    unordered_set<string> visited;
-    stack<string> s;
-    
-    // Push the start city onto the stack
-    s.push(standardCity);
-    
     cout << "DFS Visit Order:\n";
-    
-    while (!s.empty()) {
-        string current = s.top();
-        s.pop();
-        
-        // If the current city hasn't been visited
-        if (visited.find(current) == visited.end()) {
-            visited.insert(current);
-            cout << "Visiting: " << current << endl;
-            
-            // Push all unvisited neighbors onto the stack
-            // We push them in reverse order to maintain the correct visit order
-            for (auto it = adjList.at(current).rbegin(); it != adjList.at(current).rend(); ++it) {
-                string neighbor = it->first;
-                if (visited.find(neighbor) == visited.end()) {
-                    s.push(neighbor);
-                }
-            }
-        }
+    for (int city : dfsOrder(*graph.compact(), source)) {
+        cout << "Visiting: " << graph.cityName(city) << endl;
     }
-    
     cout << "DFS traversal completed.\n";
 }
+
 void Traversal::bfs(Graph& graph, const string& startCity) {
-	// Get the adjacency list from the graph
-	const auto& adjList = graph.getAdjList();
-	string standardCity = Graph::standardizeCity(startCity);
-	
-	if (adjList.find(standardCity) == adjList.end()) {
-		cout << "Start city not found in the graph.\n";
-		return;
-	}
-
-	unordered_set<string> visited;
-	queue<string> q;
-	
-	// Push the start city onto the queue
-	q.push(standardCity);
-	
-	cout << "BFS Visit Order:\n";
-	
-	while (!q.empty()) {
-		string current = q.front();
-		q.pop();
-		
-		// If the current city hasn't been visited
-		if (visited.find(current) == visited.end()) {
-			visited.insert(current);
-			cout << "Visiting: " << current << endl;
-			
-			// Push all unvisited neighbors onto the queue
-			for (const auto& neighbor : adjList.at(current)) {
-				if (visited.find(neighbor.first) == visited.end()) {
-					q.push(neighbor.first);
-				}
-			}
-		}
-	}
-	
-	cout << "BFS traversal completed.\n";
+    int source = graph.cityId(startCity);
+    if (source < 0) {
+        cout << "Start city not found in the graph.\n";
+        return;
+    }
+
+    cout << "BFS Visit Order:\n";
+    for (int city : bfsOrder(*graph.compact(), source)) {
+        cout << "Visiting: " << graph.cityName(city) << endl;
+    }
+    cout << "BFS traversal completed.\n";
 }
 
 // DFS with path capturing for GUI
 void Traversal::dfsWithPath(const Graph& graph, const string& startCity, vector<string>& path) {
     path.clear();
-    
-    // Get the adjacency list from the graph
-    const auto& adjList = graph.getAdjList();
-    string standardCity = Graph::standardizeCity(startCity);
-    
-    if (adjList.find(standardCity) == adjList.end()) {
-        return;  // Start city not found
+    int source = graph.cityId(startCity);
+    if (source >= 0) {
+        path = cityNames(graph, dfsOrder(*graph.compact(), source));
     }
-    
-    unordered_set<string> visited;
-    stack<string> s;
-    
-    // Push the start city onto the stack
-    s.push(standardCity);
-    
-    while (!s.empty()) {
-        string current = s.top();
-        s.pop();
-        
-        // If the current city hasn't been visited
-        if (visited.find(current) == visited.end()) {
-            visited.insert(current);
-            path.push_back(current);  // Add to path
-            
-            // Push all unvisited neighbors onto the stack (reverse order for correct DFS)
-            if (adjList.find(current) != adjList.end()) {
-                for (auto it = adjList.at(current).rbegin(); it != adjList.at(current).rend(); ++it) {
-                    string neighbor = it->first;
-                    if (visited.find(neighbor) == visited.end()) {
-                        s.push(neighbor);
+}
+
+// BFS with path capturing for GUI
+void Traversal::bfsWithPath(const Graph& graph, const string& startCity, vector<string>& path) {
+    path.clear();
+    int source = graph.cityId(startCity);
+    if (source < 0) {
+        return;
+    }
+    auto compact = graph.compact();
+    if (compact->liveCount >= PARALLEL_BFS_CITIES) {
+        path = cityNames(graph, parallelBfs(*compact, source, ThreadPool::shared(), true).order);
+    } else {
+        path = cityNames(graph, bfsOrder(*compact, source));
+    }
+}
+
+vector<string> Traversal::cityNames(const Graph& graph, const vector<int>& order) {
+    vector<string> names;
+    names.reserve(order.size());
+    for (int city : order) {
+        names.push_back(graph.cityName(city));
+    }
+    return names;
+}
+
+// Calls visit(city, parent, edge) in DFS order, edge being the tree edge from
+// parent that reached the city (both -1 for the source). Each frame is a city and its next unexplored
+// edge. This visits cities in the same order as pushing all neighbors in reverse
+// onto a stack of names, but the stack holds one frame per city, not per edge.
+template <typename Visit>
+static void walkDepthFirst(const CompactGraph& graph, int source, Visit visit) {
+    if (source < 0 || source >= graph.nodeCount() || !graph.isAlive(source)) {
+        return;
+    }
+
+    NodeBitset visited(graph.nodeCount());
+    vector<pair<int, int>> stack;
+    visited.set(source);
+    visit(source, -1, -1);
+    stack.emplace_back(source, graph.offsets[source]);
+
+    while (!stack.empty()) {
+        auto& [current, edge] = stack.back();
+        int end = graph.offsets[current + 1];
+        while (edge < end && visited.test(graph.targets[edge])) {
+            ++edge;
+        }
+        if (edge == end) {
+            stack.pop_back();
+            continue;
+        }
+        int treeEdge = edge++;
+        int next = graph.targets[treeEdge];
+        visited.set(next);
+        visit(next, current, treeEdge);
+        stack.emplace_back(next, graph.offsets[next]);
+    }
+}
+
+// Same for BFS; queue[head] is the next city to expand
+template <typename Visit>
+static void walkBreadthFirst(const CompactGraph& graph, int source, Visit visit) {
+    if (source < 0 || source >= graph.nodeCount() || !graph.isAlive(source)) {
+        return;
+    }
+
+    NodeBitset visited(graph.nodeCount());
+    vector<int> queue{source};
+    visited.set(source);
+    visit(source, -1, -1);
+
+    for (size_t head = 0; head < queue.size(); ++head) {
+        int current = queue[head];
+        for (int e = graph.offsets[current]; e < graph.offsets[current + 1]; ++e) {
+            if (visited.insert(graph.targets[e])) {
+                queue.push_back(graph.targets[e]);
+                visit(graph.targets[e], current, e);
+            }
+        }
+    }
+}
+
+vector<int> Traversal::dfsOrder(const CompactGraph& graph, int source) {
+    vector<int> order;
+    walkDepthFirst(graph, source, [&](int city, int, int) { order.push_back(city); });
+    return order;
+}
+
+vector<int> Traversal::bfsOrder(const CompactGraph& graph, int source) {
+    vector<int> order;
+    walkBreadthFirst(graph, source, [&](int city, int, int) { order.push_back(city); });
+    return order;
+}
+
+TraversalTree Traversal::dfsTree(const CompactGraph& graph, int source) {
+    TraversalTree tree;
+    tree.parent.assign(graph.nodeCount(), -1);
+    walkDepthFirst(graph, source, [&](int city, int parent, int edge) {
+        tree.order.push_back(city);
+        if (edge != -1) {
+            tree.parent[city] = parent;
+            tree.edges.push_back({parent, city, graph.weights[edge]});
+        }
+    });
+    return tree;
+}
+
+TraversalTree Traversal::bfsTree(const CompactGraph& graph, int source) {
+    TraversalTree tree;
+    tree.parent.assign(graph.nodeCount(), -1);
+    walkBreadthFirst(graph, source, [&](int city, int parent, int edge) {
+        tree.order.push_back(city);
+        if (edge != -1) {
+            tree.parent[city] = parent;
+            tree.edges.push_back({parent, city, graph.weights[edge]});
+        }
+    });
+    return tree;
+}
+
+HopTree Traversal::hopDistances(const CompactGraph& graph, int source) {
+    int n = graph.nodeCount();
+    HopTree tree;
+    tree.hops.assign(n, -1);
+    tree.parent.assign(n, -1);
+    if (source < 0 || source >= n || !graph.isAlive(source)) {
+        return tree;
+    }
+
+    vector<int> frontier{source};
+    vector<int> next;
+    NodeBitset inFrontier(n);
+    tree.hops[source] = 0;
+
+    // Edges still to be checked from each side, as in Beamer's heuristic
+    long long unexploredEdges = graph.edgeCount() - graph.inDegree(source);
+    long long frontierEdges = graph.outDegree(source);
+    bool bottomUp = false;
+
+    for (int level = 0; !frontier.empty(); ++level) {
+        if (!bottomUp && frontierEdges > unexploredEdges / ALPHA) {
+            bottomUp = true;
+        } else if (bottomUp && static_cast<long long>(frontier.size()) * BETA < n) {
+            bottomUp = false;
+        }
+
+        next.clear();
+        if (bottomUp) {
+            // Every unvisited city looks for a parent among its in-neighbors
+            inFrontier.reset(n);
+            for (int u : frontier) {
+                inFrontier.set(u);
+            }
+            for (int v = 0; v < n; ++v) {
+                if (tree.hops[v] != -1 || !graph.isAlive(v)) continue;
+                for (int e = graph.inOffsets[v]; e < graph.inOffsets[v + 1]; ++e) {
+                    if (inFrontier.test(graph.sources[e])) {
+                        tree.hops[v] = level + 1;
+                        tree.parent[v] = graph.sources[e];
+                        next.push_back(v);
+                        break;
+                    }
+                }
+            }
+            tree.bottomUpLevels += next.empty() ? 0 : 1;
+        } else {
+            for (int u : frontier) {
+                for (int e = graph.offsets[u]; e < graph.offsets[u + 1]; ++e) {
+                    int v = graph.targets[e];
+                    if (tree.hops[v] == -1) {
+                        tree.hops[v] = level + 1;
+                        tree.parent[v] = u;
+                        next.push_back(v);
                     }
                 }
             }
         }
+
+        frontierEdges = 0;
+        for (int v : next) {
+            frontierEdges += graph.outDegree(v);
+            unexploredEdges -= graph.inDegree(v);
+        }
+        tree.levels += next.empty() ? 0 : 1;
+        frontier.swap(next);
     }
+    return tree;
 }
 
-// BFS with path capturing for GUI
-void Traversal::bfsWithPath(const Graph& graph, const string& startCity, vector<string>& path) {
-    path.clear();
-    
-    // Get the adjacency list from the graph
-    const auto& adjList = graph.getAdjList();
-    string standardCity = Graph::standardizeCity(startCity);
-    
-    if (adjList.find(standardCity) == adjList.end()) {
-        return;  // Start city not found
+void Traversal::showHopDistances(Graph& graph, const string& startCity) {
+    int source = graph.cityId(startCity);
+    if (source < 0) {
+        cout << "Start city not found in the graph.\n";
+        return;
     }
-    
-    unordered_set<string> visited;
-    queue<string> q;
-    
-    // Enqueue the start city
-    q.push(standardCity);
-    visited.insert(standardCity);
-    
-    while (!q.empty()) {
-        string current = q.front();
-        q.pop();
-        
-        path.push_back(current);  // Add to path
-        
-        // Enqueue all unvisited neighbors
-        if (adjList.find(current) != adjList.end()) {
-            for (const auto& [neighbor, _] : adjList.at(current)) {
-                if (visited.find(neighbor) == visited.end()) {
-                    visited.insert(neighbor);
-                    q.push(neighbor);
+
+    HopTree tree = hopDistances(*graph.compact(), source);
+
+    vector<int> reached;
+    for (int city = 0; city < static_cast<int>(tree.hops.size()); ++city) {
+        if (tree.hops[city] != -1) {
+            reached.push_back(city);
+        }
+    }
+    stable_sort(reached.begin(), reached.end(), [&](int a, int b) {
+        return tree.hops[a] < tree.hops[b];
+    });
+
+    cout << "Hop Distances from " << graph.cityName(source) << ":\n";
+    for (int city : reached) {
+        cout << graph.cityName(city) << ": " << tree.hops[city] << " hop(s)";
+        if (tree.parent[city] != -1) {
+            cout << " (via " << graph.cityName(tree.parent[city]) << ")";
+        }
+        cout << endl;
+    }
+    cout << reached.size() << " cities reached in " << tree.levels << " level(s), "
+         << tree.bottomUpLevels << " expanded bottom-up.\n";
+}
+
+LevelOrder Traversal::parallelBfs(const CompactGraph& graph, int source, ThreadPool& pool,
+                                  bool deterministic) {
+    int n = graph.nodeCount();
+    LevelOrder result;
+    result.level.assign(n, -1);
+    if (source < 0 || source >= n || !graph.isAlive(source)) {
+        result.levelStart.push_back(0);
+        return result;
+    }
+
+    vector<int>& order = result.order;
+    vector<int>& level = result.level;
+    order.reserve(graph.liveCount);
+    order.push_back(source);
+    level[source] = 0;
+
+    // Scheduling-dependent mode: visited bits claimed with fetch_or
+    vector<atomic<uint64_t>> visited;
+    vector<vector<int>> buffers;
+    // Deterministic mode: every unvisited city keeps the smallest key of the edges
+    // reaching it, where keys number the frontier's edges in serial scan order
+    vector<atomic<long long>> claim;
+    vector<long long> edgeKey;
+    vector<size_t> owned;
+    long long keyBase = 0;
+
+    if (deterministic) {
+        claim = vector<atomic<long long>>(n);
+        for (auto& key : claim) {
+            key.store(LLONG_MAX, memory_order_relaxed);
+        }
+    } else {
+        visited = vector<atomic<uint64_t>>((static_cast<size_t>(n) + 63) / 64);
+        for (auto& word : visited) {
+            word.store(0, memory_order_relaxed);
+        }
+        visited[source >> 6].fetch_or(uint64_t(1) << (source & 63), memory_order_relaxed);
+        buffers.resize(pool.size());
+    }
+
+    // Narrow levels are expanded on the calling thread; waking the pool costs more
+    auto forFrontier = [&](size_t width, const function<void(size_t, unsigned)>& task) {
+        if (width < PARALLEL_LEVEL_WIDTH) {
+            for (size_t i = 0; i < width; ++i) {
+                task(i, 0);
+            }
+        } else {
+            pool.parallelFor(width, task, 64);
+        }
+    };
+
+    size_t begin = 0;
+    for (int depth = 0; begin < order.size(); ++depth) {
+        size_t end = order.size();
+        size_t width = end - begin;
+        result.levelStart.push_back(static_cast<int>(begin));
+
+        if (deterministic) {
+            edgeKey.resize(width + 1);
+            edgeKey[0] = keyBase;
+            for (size_t i = 0; i < width; ++i) {
+                edgeKey[i + 1] = edgeKey[i] + graph.outDegree(order[begin + i]);
+            }
+            keyBase = edgeKey[width];
+
+            forFrontier(width, [&](size_t i, unsigned) {
+                int u = order[begin + i];
+                for (int e = graph.offsets[u]; e < graph.offsets[u + 1]; ++e) {
+                    int v = graph.targets[e];
+                    if (level[v] != -1) continue;
+                    long long key = edgeKey[i] + (e - graph.offsets[u]);
+                    long long current = claim[v].load(memory_order_relaxed);
+                    while (key < current &&
+                           !claim[v].compare_exchange_weak(current, key, memory_order_relaxed)) {
+                    }
+                }
+            });
+
+            // Each frontier city keeps the cities it claimed, in edge order
+            owned.assign(width + 1, 0);
+            auto ownsEdge = [&](size_t i, int u, int e) {
+                return claim[graph.targets[e]].load(memory_order_relaxed) == edgeKey[i] + (e - graph.offsets[u]);
+            };
+            forFrontier(width, [&](size_t i, unsigned) {
+                int u = order[begin + i];
+                for (int e = graph.offsets[u]; e < graph.offsets[u + 1]; ++e) {
+                    owned[i + 1] += ownsEdge(i, u, e) ? 1 : 0;
+                }
+            });
+            for (size_t i = 0; i < width; ++i) {
+                owned[i + 1] += owned[i];
+            }
+            order.resize(end + owned[width]);
+            forFrontier(width, [&](size_t i, unsigned) {
+                int u = order[begin + i];
+                size_t slot = end + owned[i];
+                for (int e = graph.offsets[u]; e < graph.offsets[u + 1]; ++e) {
+                    if (ownsEdge(i, u, e)) {
+                        level[graph.targets[e]] = depth + 1;
+                        order[slot++] = graph.targets[e];
+                    }
                 }
+            });
+        } else {
+            forFrontier(width, [&](size_t i, unsigned worker) {
+                int u = order[begin + i];
+                for (int e = graph.offsets[u]; e < graph.offsets[u + 1]; ++e) {
+                    int v = graph.targets[e];
+                    uint64_t mask = uint64_t(1) << (v & 63);
+                    if (visited[v >> 6].load(memory_order_relaxed) & mask) continue;
+                    if (visited[v >> 6].fetch_or(mask, memory_order_relaxed) & mask) continue;
+                    level[v] = depth + 1;
+                    buffers[worker].push_back(v);
+                }
+            });
+
+            // Concatenate the per-worker buffers, each copied by its own task
+            vector<size_t> offset(buffers.size() + 1, end);
+            for (size_t w = 0; w < buffers.size(); ++w) {
+                offset[w + 1] = offset[w] + buffers[w].size();
+            }
+            order.resize(offset.back());
+            auto drain = [&](size_t w, unsigned) {
+                copy(buffers[w].begin(), buffers[w].end(), order.begin() + offset[w]);
+                buffers[w].clear();
+            };
+            if (order.size() - end < PARALLEL_LEVEL_WIDTH) {
+                for (size_t w = 0; w < buffers.size(); ++w) {
+                    drain(w, 0);
+                }
+            } else {
+                pool.parallelFor(buffers.size(), drain);
             }
         }
+        begin = end;
+    }
+    result.levelStart.push_back(static_cast<int>(order.size()));
+    return result;
+}
+
+TraversalStep Traversal::firstReachable(const Graph& graph, int source, const function<bool(int)>& matches) {
+    TraversalCursor cursor(graph.compact(), source, TraversalCursor::Order::BreadthFirst);
+    TraversalStep step;
+    while (cursor.next(step)) {
+        if (matches(step.node)) {
+            return step;
+        }
     }
+    return TraversalStep();
 }
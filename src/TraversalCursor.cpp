@@ -0,0 +1,81 @@
+#include "../include/TraversalCursor.hpp"
+
+using namespace std;
+
+// Produced BFS entries are dropped from the front of the queue in batches of this size
+static const size_t QUEUE_COMPACTION = 4096;
+
+TraversalCursor::TraversalCursor(shared_ptr<const CompactGraph> graph, int source, Order order)
+    : graph(move(graph)), visitOrder(order) {
+    const CompactGraph& g = *this->graph;
+    seen.reset(g.nodeCount());
+    if (source < 0 || source >= g.nodeCount() || !g.isAlive(source)) {
+        return;   // Nothing to produce
+    }
+
+    seen.set(source);
+    if (visitOrder == Order::DepthFirst) {
+        start = source;
+    } else {
+        queue.push_back({source, 0, -1});
+    }
+}
+
+bool TraversalCursor::next(TraversalStep& step) {
+    bool found = visitOrder == Order::DepthFirst ? nextDepthFirst(step) : nextBreadthFirst(step);
+    if (found) {
+        visited++;
+    }
+    return found;
+}
+
+bool TraversalCursor::nextDepthFirst(TraversalStep& step) {
+    const CompactGraph& g = *graph;
+    if (start != -1) {
+        step = {start, 0, -1};
+        stack.emplace_back(start, g.offsets[start]);
+        start = -1;
+        return true;
+    }
+
+    // Resume the branch where the previous call stopped
+    while (!stack.empty()) {
+        auto& [current, edge] = stack.back();
+        int end = g.offsets[current + 1];
+        while (edge < end && seen.test(g.targets[edge])) {
+            ++edge;
+        }
+        if (edge == end) {
+            stack.pop_back();
+            continue;
+        }
+
+        int parent = current;
+        int city = g.targets[edge++];
+        seen.set(city);
+        stack.emplace_back(city, g.offsets[city]);
+        step = {city, static_cast<int>(stack.size()) - 1, parent};
+        return true;
+    }
+    return false;
+}
+
+bool TraversalCursor::nextBreadthFirst(TraversalStep& step) {
+    const CompactGraph& g = *graph;
+    if (head == queue.size()) {
+        return false;
+    }
+
+    step = queue[head++];
+    for (int e = g.offsets[step.node]; e < g.offsets[step.node + 1]; ++e) {
+        if (seen.insert(g.targets[e])) {
+            queue.push_back({g.targets[e], step.depth + 1, step.node});
+        }
+    }
+
+    if (head >= QUEUE_COMPACTION && head * 2 >= queue.size()) {
+        queue.erase(queue.begin(), queue.begin() + head);
+        head = 0;
+    }
+    return true;
+}
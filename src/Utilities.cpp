@@ -23,6 +23,13 @@ void Utilities::displayMenu() {
     cout << "10. Exit\n";
     cout << "11. Sort all connections by city name\n";
     cout << "12. Sort all connections by distance\n";
+    cout << "13. Update Edge Distance\n";
+    cout << "14. Cities Within Budget (isochrone)\n";
+    cout << "15. Nearest Facility Assignment\n";
+    cout << "16. Transit Hubs (centrality ranking)\n";
+    cout << "17. Diameter and Eccentricity\n";
+    cout << "18. Corridor Capacity (max flow / min cut)\n";
+    cout << "19. Distance Distribution (HyperANF estimate)\n";
     cout << "Select option: ";
 }
 
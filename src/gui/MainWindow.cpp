@@ -370,6 +370,10 @@ MainWindow::MainWindow(QWidget *parent)
     createOptionsPanel();
     createLogPanel();
     
+    traversalTimer = new QTimer(this);
+    traversalTimer->setInterval(400);
+    connect(traversalTimer, &QTimer::timeout, this, &MainWindow::advanceTraversal);
+    
     // Initial update
     updateGraphDisplay();
     
@@ -793,8 +797,10 @@ void MainWindow::createOptionsPanel() {
     QHBoxLayout *edgeButtonLayout = new QHBoxLayout();
     addEdgeButton = new QPushButton("Add Edge");
     deleteEdgeButton = new QPushButton("Delete Edge");
+    updateEdgeButton = new QPushButton("Update Distance");
     edgeButtonLayout->addWidget(addEdgeButton);
     edgeButtonLayout->addWidget(deleteEdgeButton);
+    edgeButtonLayout->addWidget(updateEdgeButton);
     
     edgeLayout->addLayout(edgeCityLayout);
     edgeLayout->addWidget(distanceLabel);
@@ -813,13 +819,12 @@ void MainWindow::createOptionsPanel() {
     dfsButton = new QPushButton("DFS Traverse");
     bfsButton = new QPushButton("BFS Traverse");
     
-    // Connect standard traversal buttons to just highlight paths
-    connect(dfsButton, &QPushButton::clicked, this, &MainWindow::performDFS);
-    connect(bfsButton, &QPushButton::clicked, this, &MainWindow::performBFS);
-    
     traversalButtonLayout->addWidget(dfsButton);
     traversalButtonLayout->addWidget(bfsButton);
     
+    animateTraversalCheck = new QCheckBox("Animate step by step");
+    animateTraversalCheck->setToolTip("Reveal the traversal one city at a time");
+    
     // Add spanning tree visualization buttons
     QHBoxLayout *spanningTreeButtonLayout = new QHBoxLayout();
     QPushButton *dfsTreeButton = new QPushButton("DFS Tree");
@@ -828,137 +833,41 @@ void MainWindow::createOptionsPanel() {
     dfsTreeButton->setToolTip("Visualize DFS spanning tree");
     bfsTreeButton->setToolTip("Visualize BFS spanning tree");
     
-    // For tree buttons, collect the tree edges and visualize spanning tree
-    connect(dfsTreeButton, &QPushButton::clicked, [this]() {
-        if (startCityInput->text().trimmed().isEmpty()) {
-            logMessage("Error: Please enter a starting city");
-            return;
-        }
-        
-        QString startCity = startCityInput->text().trimmed();
-        if (!graph.cityExists(startCity.toStdString())) {
-            logMessage("Error: City " + startCity + " does not exist");
-            return;
-        }
-        
-        // Capture the path from DFS traversal
-        vector<string> path;
-        vector<pair<string, string>> treeEdges;
-        
-        // Get DFS path
-        Traversal::dfsWithPath(graph, startCity.toStdString(), path);
-        
-        // Build tree edges more reliably by tracking parent-child relationships
-        unordered_map<string, string> parentOf;
-        unordered_set<string> visited;
-        
-        // Mark the start node as visited
-        visited.insert(path[0]);
-        
-        // For each node in the DFS path, find its unvisited neighbors
-        // and create a tree edge to the first one that appears later in the path
-        for (size_t i = 0; i < path.size(); ++i) {
-            const string& current = path[i];
-            
-            // For each neighbor of the current node
-            const auto& neighbors = graph.getAdjList().at(current);
-            for (const auto& [neighbor, _] : neighbors) {
-                // If this neighbor hasn't been visited yet and appears later in the path,
-                // add it to the tree
-                if (visited.find(neighbor) == visited.end()) {
-                    // Check if this neighbor appears in the DFS path after the current node
-                    auto it = std::find(path.begin() + i + 1, path.end(), neighbor);
-                    if (it != path.end()) {
-                        // This is a tree edge
-                        treeEdges.push_back({current, neighbor});
-                        parentOf[neighbor] = current;
-                        visited.insert(neighbor);
-                    }
-                }
-            }
-        }
-        
-        // Make sure all nodes in path are connected in the tree
-        // by adding edges to any remaining unvisited nodes
-        for (size_t i = 1; i < path.size(); ++i) {
-            const string& current = path[i];
-            
-            // If this node doesn't have a parent yet, find a visited node
-            // that has an edge to it and add that edge to the tree
-            if (parentOf.find(current) == parentOf.end()) {
-                for (const auto& [city, neighbors] : graph.getAdjList()) {
-                    if (visited.find(city) != visited.end() && city != current) {
-                        for (const auto& [neighbor, _] : neighbors) {
-                            if (neighbor == current) {
-                                treeEdges.push_back({city, current});
-                                parentOf[current] = city;
-                                break;
-                            }
-                        }
-                        if (parentOf.find(current) != parentOf.end()) {
-                            break;
-                        }
-                    }
-                }
-            }
-        }
-        
-        visualizeSpanningTree(path, treeEdges, true);
-    });
-    
-    connect(bfsTreeButton, &QPushButton::clicked, [this]() {
-        if (startCityInput->text().trimmed().isEmpty()) {
-            logMessage("Error: Please enter a starting city");
-            return;
-        }
-        
-        QString startCity = startCityInput->text().trimmed();
-        if (!graph.cityExists(startCity.toStdString())) {
-            logMessage("Error: City " + startCity + " does not exist");
-            return;
-        }
-        
-        // Capture the path from BFS traversal
-        vector<string> path;
-        vector<pair<string, string>> treeEdges;
-        
-        // Get BFS path
-        Traversal::bfsWithPath(graph, startCity.toStdString(), path);
-        
-        // Create a map to track the level of each node in the BFS tree
-        std::unordered_map<string, int> levels;
-        std::unordered_map<string, string> parents;
-        
-        // First node is at level 0
-        levels[path[0]] = 0;
-        
-        // Reconstruct the BFS tree
-        for (size_t i = 0; i < path.size(); i++) {
-            const string& current = path[i];
-            int currentLevel = levels[current];
-            
-            // Check neighbors of the current node
-            for (const auto& [neighbor, _] : graph.getAdjList().at(current)) {
-                // If neighbor not yet assigned a level, it's a child in the BFS tree
-                if (levels.find(neighbor) == levels.end() && 
-                    std::find(path.begin(), path.end(), neighbor) != path.end()) {
-                    levels[neighbor] = currentLevel + 1;
-                    parents[neighbor] = current;
-                    treeEdges.push_back({current, neighbor});
-                }
-            }
-        }
-        
-        visualizeSpanningTree(path, treeEdges, false);
-    });
+    // The traversal itself records the tree edges, weights included
+    connect(dfsTreeButton, &QPushButton::clicked, [this]() { showSpanningTree(true); });
+    connect(bfsTreeButton, &QPushButton::clicked, [this]() { showSpanningTree(false); });
     
     spanningTreeButtonLayout->addWidget(dfsTreeButton);
     spanningTreeButtonLayout->addWidget(bfsTreeButton);
     
+    // Weighted counterparts: cheapest edges instead of visit order
+    QHBoxLayout *minimumSpanningButtonLayout = new QHBoxLayout();
+    QPushButton *forestButton = new QPushButton("Min Spanning Forest");
+    QPushButton *arborescenceButton = new QPushButton("Min Arborescence");
+    
+    forestButton->setToolTip("Cheapest edges linking every city, ignoring direction");
+    arborescenceButton->setToolTip("Cheapest directed tree reaching everything from the starting city");
+    
+    connect(forestButton, &QPushButton::clicked, [this]() { showMinimumSpanning(false); });
+    connect(arborescenceButton, &QPushButton::clicked, [this]() { showMinimumSpanning(true); });
+    
+    minimumSpanningButtonLayout->addWidget(forestButton);
+    minimumSpanningButtonLayout->addWidget(arborescenceButton);
+    
+    componentsButton = new QPushButton("Strong Components");
+    componentsButton->setToolTip("Colour cities that can all reach each other alike");
+    
+    sizeByCentralityCheck = new QCheckBox("Size cities by betweenness");
+    sizeByCentralityCheck->setToolTip("Draw cities that many shortest routes pass through larger");
+    
     traversalLayout->addWidget(startLabel);
     traversalLayout->addWidget(startCityInput);
     traversalLayout->addLayout(traversalButtonLayout);
+    traversalLayout->addWidget(animateTraversalCheck);
     traversalLayout->addLayout(spanningTreeButtonLayout);
+    traversalLayout->addLayout(minimumSpanningButtonLayout);
+    traversalLayout->addWidget(componentsButton);
+    traversalLayout->addWidget(sizeByCentralityCheck);
     traversalGroup->setLayout(traversalLayout);
     
     // 4. Pathfinding Group
@@ -988,8 +897,31 @@ void MainWindow::createOptionsPanel() {
     pathfindingButtonLayout->addWidget(dijkstraButton);
     pathfindingButtonLayout->addWidget(aStarButton);
     
+    // Max flow: distances read as road capacities between "From" and "To"
+    minCutButton = new QPushButton("Max Flow / Min Cut");
+    minCutButton->setToolTip("Capacity from \"From\" to \"To\", reading distances as capacities, and the roads that limit it");
+    
+    // Isochrone: shade everything reachable from "From" by cost band
+    QHBoxLayout *isochroneLayout = new QHBoxLayout();
+    budgetInput = new QLineEdit();
+    budgetInput->setPlaceholderText("Budgets, e.g. 10,20,30");
+    isochroneButton = new QPushButton("Reachable Within");
+    isochroneLayout->addWidget(budgetInput);
+    isochroneLayout->addWidget(isochroneButton);
+    
     pathfindingLayout->addLayout(pathCityLayout);
     pathfindingLayout->addLayout(pathfindingButtonLayout);
+    pathfindingLayout->addWidget(minCutButton);
+    // Service regions: colour every city by its nearest facility
+    QHBoxLayout *regionsLayout = new QHBoxLayout();
+    facilitiesInput = new QLineEdit();
+    facilitiesInput->setPlaceholderText("Facilities, e.g. A,B,C");
+    serviceRegionsButton = new QPushButton("Service Regions");
+    regionsLayout->addWidget(facilitiesInput);
+    regionsLayout->addWidget(serviceRegionsButton);
+    
+    pathfindingLayout->addLayout(isochroneLayout);
+    pathfindingLayout->addLayout(regionsLayout);
     pathfindingGroup->setLayout(pathfindingLayout);
     
     // Add all groups to the options panel
@@ -1004,10 +936,16 @@ void MainWindow::createOptionsPanel() {
     connect(deleteCityButton, &QPushButton::clicked, this, &MainWindow::deleteCity);
     connect(addEdgeButton, &QPushButton::clicked, this, &MainWindow::addEdge);
     connect(deleteEdgeButton, &QPushButton::clicked, this, &MainWindow::deleteEdge);
+    connect(updateEdgeButton, &QPushButton::clicked, this, &MainWindow::updateEdgeDistance);
     connect(dfsButton, &QPushButton::clicked, this, &MainWindow::performDFS);
     connect(bfsButton, &QPushButton::clicked, this, &MainWindow::performBFS);
     connect(dijkstraButton, &QPushButton::clicked, this, &MainWindow::findDijkstraPath);
     connect(aStarButton, &QPushButton::clicked, this, &MainWindow::findAStarPath);
+    connect(isochroneButton, &QPushButton::clicked, this, &MainWindow::showIsochrone);
+    connect(serviceRegionsButton, &QPushButton::clicked, this, &MainWindow::showServiceRegions);
+    connect(minCutButton, &QPushButton::clicked, this, &MainWindow::showMinCut);
+    connect(componentsButton, &QPushButton::clicked, this, &MainWindow::showStrongComponents);
+    connect(sizeByCentralityCheck, &QCheckBox::toggled, this, [this]() { refreshDisplay(); });
 }
 
 void MainWindow::createLogPanel() {
@@ -1065,9 +1003,13 @@ void MainWindow::loadGraph() {
     QString fileName = QFileDialog::getOpenFileName(this, "Load Graph", "data/", "Text Files (*.txt)");
     if (!fileName.isEmpty()) {
         try {
-        ioManager.loadGraph(fileName.toStdString(), graph);
-        updateGraphDisplay();
-        logMessage("Graph loaded from " + fileName);
+            // Loading clears the graph and restarts city ids; drop everything holding old ones
+            activeRoute.reset();
+            stopTraversal();
+            nodesById.clear();
+            ioManager.loadGraph(fileName.toStdString(), graph);
+            updateGraphDisplay();
+            logMessage("Graph loaded from " + fileName);
         } catch (const std::exception& e) {
             logMessage("Error loading graph: " + QString(e.what()));
             QMessageBox::critical(this, "Load Error", "Failed to load graph: " + QString(e.what()));
@@ -1106,7 +1048,7 @@ void MainWindow::addCity() {
     }
     
     graph.addCity(cityName.toStdString());
-    updateGraphDisplay();
+    refreshDisplay();
     cityNameInput->clear();
     
     // Add debug message
@@ -1126,7 +1068,7 @@ void MainWindow::deleteCity() {
     }
     
     graph.deleteCity(cityName.toStdString());
-    updateGraphDisplay();
+    refreshDisplay();
     cityNameInput->clear();
 }
 
@@ -1149,7 +1091,7 @@ void MainWindow::addEdge() {
     }
     
     graph.addEdge(fromCity.toStdString(), toCity.toStdString(), distance);
-    updateGraphDisplay();
+    refreshDisplay();
     
     // Clear inputs
     fromCityInput->clear();
@@ -1167,13 +1109,39 @@ void MainWindow::deleteEdge() {
     }
     
     graph.deleteEdge(fromCity.toStdString(), toCity.toStdString());
-    updateGraphDisplay();
+    refreshDisplay();
     
     // Clear inputs
     fromCityInput->clear();
     toCityInput->clear();
 }
 
+void MainWindow::updateEdgeDistance() {
+    QString fromCity = fromCityInput->text().trimmed();
+    QString toCity = toCityInput->text().trimmed();
+    QString distanceText = distanceInput->text().trimmed();
+    
+    if (fromCity.isEmpty() || toCity.isEmpty()) {
+        logMessage("Error: City names cannot be empty");
+        return;
+    }
+    
+    bool ok;
+    int distance = distanceText.toInt(&ok);
+    if (!ok || distance < 0) {
+        logMessage("Error: Distance must be a non-negative number");
+        return;
+    }
+    
+    graph.updateEdge(fromCity.toStdString(), toCity.toStdString(), distance);
+    refreshDisplay();
+    
+    // Clear inputs
+    fromCityInput->clear();
+    toCityInput->clear();
+    distanceInput->clear();
+}
+
 // Traversal Operations
 void MainWindow::performDFS() {
     QString startCity = startCityInput->text().trimmed();
@@ -1187,19 +1155,18 @@ void MainWindow::performDFS() {
         return;
     }
     
-    // Capture the path from DFS traversal
-    vector<string> path;
-    Traversal::dfsWithPath(graph, startCity.toStdString(), path);
-    
-    // Convert path to QStringList for highlighting
-    QStringList pathStringList;
-    for (const auto& city : path) {
-        pathStringList << QString::fromStdString(city);
+    if (animateTraversalCheck->isChecked()) {
+        startTraversal(TraversalCursor::Order::DepthFirst, startCity);
+        return;
     }
     
+    // Visit order by city id straight from the CSR kernel; names are only looked up for the log
+    activeRoute.reset();
+    vector<int> visitOrder = Traversal::dfsOrder(*graph.compact(), graph.cityId(startCity.toStdString()));
+    
     // Update display with highlighted path
-    updateGraphDisplay(pathStringList.join(","));
-    logMessage("DFS traversal from " + startCity + ": " + pathStringList.join(" -> "));
+    updateGraphDisplay(visitOrder);
+    logMessage("DFS traversal from " + startCity + ": " + pathLabel(visitOrder));
 }
 
 void MainWindow::performBFS() {
@@ -1214,75 +1181,161 @@ void MainWindow::performBFS() {
         return;
     }
     
-    // Capture the path from BFS traversal
-    vector<string> path;
-    vector<pair<string, string>> treeEdges; // Track parent-child edges for spanning tree
+    if (animateTraversalCheck->isChecked()) {
+        startTraversal(TraversalCursor::Order::BreadthFirst, startCity);
+        return;
+    }
+    
+    // Visit order by city id straight from the CSR kernels; names are only looked up for the log
+    activeRoute.reset();
+    auto compact = graph.compact();
+    int source = graph.cityId(startCity.toStdString());
+    vector<int> visitOrder = compact->liveCount >= Traversal::PARALLEL_BFS_CITIES
+        ? Traversal::parallelBfs(*compact, source, ThreadPool::shared(), true).order
+        : Traversal::bfsOrder(*compact, source);
     
-    // Perform BFS traversal
-    Traversal::bfsWithPath(graph, startCity.toStdString(), path);
+    // Just highlight the path on the original graph
+    updateGraphDisplay(visitOrder);
+    
+    logMessage("BFS traversal from " + startCity + ": " + pathLabel(visitOrder));
+}
+
+void MainWindow::startTraversal(TraversalCursor::Order order, const QString &startCity) {
+    activeRoute.reset();
+    updateGraphDisplay();
     
-    // Convert path to QStringList for highlighting
-    QStringList pathStringList;
-    for (const auto& city : path) {
-        pathStringList << QString::fromStdString(city);
+    // Nothing is computed ahead; each tick asks the cursor for one more city
+    traversalCursor = make_unique<TraversalCursor>(graph.compact(), graph.cityId(startCity.toStdString()), order);
+    logMessage(QString("Animating %1 from %2")
+              .arg(order == TraversalCursor::Order::DepthFirst ? "DFS" : "BFS", startCity));
+    advanceTraversal();
+    traversalTimer->start();
+}
+
+void MainWindow::stopTraversal() {
+    if (traversalTimer) {
+        traversalTimer->stop();
+    }
+    traversalCursor.reset();
+}
+
+void MainWindow::advanceTraversal() {
+    if (!traversalCursor) {
+        traversalTimer->stop();
+        return;
     }
     
-    // Just highlight the path on the original graph
-    updateGraphDisplay(pathStringList.join(","));
+    QString name = traversalCursor->order() == TraversalCursor::Order::DepthFirst ? "DFS" : "BFS";
+    TraversalStep step;
+    if (!traversalCursor->next(step)) {
+        logMessage(QString("%1 animation finished, %2 cities visited")
+                  .arg(name)
+                  .arg(static_cast<qulonglong>(traversalCursor->visitedCount())));
+        stopTraversal();
+        return;
+    }
+    
+    auto nodeFor = [this](int city) -> DraggableNode* {
+        return city >= 0 && city < nodesById.size() ? nodesById[city] : nullptr;
+    };
     
-    logMessage("BFS traversal from " + startCity + ": " + pathStringList.join(" -> "));
+    // Colour the city and draw the tree edge it was reached by
+    DraggableNode *node = nodeFor(step.node);
+    DraggableNode *parentNode = nodeFor(step.parent);
+    if (node && parentNode) {
+        drawCurvedArrow(graphScene, parentNode->pos(), node->pos(), "", QColor(255, 102, 0), 3.0, true, false);
+    }
+    if (node) {
+        node->setBrush(QBrush(QColor(255, 102, 0)));
+    }
+    
+    QString city = QString::fromStdString(graph.cityName(step.node));
+    if (step.parent == -1) {
+        logMessage(name + " visiting " + city);
+    } else {
+        logMessage(QString("%1 visiting %2 (depth %3, from %4)")
+                  .arg(name, city)
+                  .arg(step.depth)
+                  .arg(QString::fromStdString(graph.cityName(step.parent))));
+    }
 }
 
-void MainWindow::visualizeSpanningTree(const vector<string>& path, 
-                                     const vector<pair<string, string>>& treeEdges, 
-                                     bool isDFS) {
-    if (path.empty()) {
+void MainWindow::showSpanningTree(bool isDFS) {
+    QString startCity = startCityInput->text().trimmed();
+    if (startCity.isEmpty()) {
+        logMessage("Error: Please enter a starting city");
+        return;
+    }
+    
+    int source = graph.cityId(startCity.toStdString());
+    if (source < 0) {
+        logMessage("Error: City " + startCity + " does not exist");
+        return;
+    }
+    
+    auto compact = graph.compact();
+    TraversalTree tree = isDFS ? Traversal::dfsTree(*compact, source) : Traversal::bfsTree(*compact, source);
+    visualizeSpanningTree(tree.order, tree.edges,
+                          QString("%1 Spanning Tree from %2")
+                              .arg(isDFS ? "DFS" : "BFS", QString::fromStdString(graph.cityName(source))));
+}
+
+void MainWindow::showMinimumSpanning(bool arborescence) {
+    auto compact = graph.compact();
+    SpanningStructure result;
+    QString title;
+    
+    if (arborescence) {
+        QString startCity = startCityInput->text().trimmed();
+        if (startCity.isEmpty()) {
+            logMessage("Error: Please enter a starting city");
+            return;
+        }
+        int root = graph.cityId(startCity.toStdString());
+        if (root < 0) {
+            logMessage("Error: City " + startCity + " does not exist");
+            return;
+        }
+        result = MinimumSpanning::arborescence(*compact, root);
+        title = QString("Minimum Arborescence from %1").arg(QString::fromStdString(graph.cityName(root)));
+    } else {
+        result = MinimumSpanning::forest(*compact, ThreadPool::shared());
+        title = result.treeCount > 1 ? QString("Minimum Spanning Forest (%1 trees)").arg(result.treeCount)
+                                     : QString("Minimum Spanning Tree");
+    }
+    
+    visualizeSpanningTree(result.nodes, result.edges, title);
+    logMessage(QString("%1: total distance %2").arg(title).arg(result.totalDistance));
+}
+
+void MainWindow::visualizeSpanningTree(const vector<int>& nodes, const vector<TreeEdge>& edges, const QString& title) {
+    if (nodes.empty()) {
         logMessage("Error: Empty traversal path");
         return;
     }
     
-    logMessage(QString("Visualizing %1 spanning tree from %2").arg(
-        isDFS ? "DFS" : "BFS",
-        QString::fromStdString(path[0])
-    ));
+    activeRoute.reset();
+    stopTraversal();
+    logMessage("Visualizing " + title);
     
     // Clear the scene
     graphScene->clear();
     nodeItems.clear();
+    nodesById.clear();
     
-    // Get the original graph structure for reference
-    const auto& originalAdjList = graph.getAdjList();
-    
-    // Create a simplified adjacency list containing only the tree edges
+    // Adjacency list containing only the tree edges, with their real distances
     unordered_map<string, vector<pair<string, int>>> treeAdjList;
-    
-    // Initialize nodes
-    for (const auto& city : path) {
-        treeAdjList[city] = vector<pair<string, int>>();
-    }
-    
-    // Add tree edges to the adjacency list
-    // We assign a standard weight of 1 for simplicity
-    for (const auto& [parent, child] : treeEdges) {
-        // Find original edge weight if it exists
-        int weight = 1;
-        auto it = originalAdjList.find(parent);
-        if (it != originalAdjList.end()) {
-            for (const auto& [neighbor, neighborWeight] : it->second) {
-                if (neighbor == child) {
-                    weight = neighborWeight;
-                    break;
-                }
-            }
-        }
-        
-        treeAdjList[parent].push_back({child, weight});
+    for (int city : nodes) {
+        treeAdjList[graph.cityName(city)];
+    }
+    for (const auto& edge : edges) {
+        treeAdjList[graph.cityName(edge.parent)].push_back({graph.cityName(edge.child), edge.distance});
     }
     
     // Create a node position map
     QMap<QString, QPointF> nodePositions;
     
-    // Use hierarchical layout for both DFS and BFS trees since it works well
+    // Hierarchical layout suits every kind of tree, and forests too
     QMap<QString, int> nodeDegrees;
     for (const auto& [city, neighbors] : treeAdjList) {
         QString cityStr = QString::fromStdString(city);
@@ -1301,14 +1354,8 @@ void MainWindow::visualizeSpanningTree(const vector<string>& path,
     graphView->fitInView(graphScene->sceneRect(), Qt::KeepAspectRatio);
     graphView->centerOn(0, 0);
     
-    // Add a title showing the algorithm used
-    QString titleText = QString("%1 Spanning Tree from %2").arg(
-        isDFS ? "DFS" : "BFS",
-        QString::fromStdString(path[0])
-    );
-    
     // Create the title with a background
-    QGraphicsTextItem *titleItem = graphScene->addText(titleText);
+    QGraphicsTextItem *titleItem = graphScene->addText(title);
     QFont titleFont = titleItem->font();
     titleFont.setPointSize(14);
     titleFont.setBold(true);
@@ -1329,8 +1376,8 @@ void MainWindow::visualizeSpanningTree(const vector<string>& path,
     panel->setZValue(titleItem->zValue() - 1);
     
     logMessage(QString("Spanning tree visualization complete (%1 nodes, %2 edges)")
-              .arg(path.size())
-              .arg(treeEdges.size()));
+              .arg(static_cast<int>(nodes.size()))
+              .arg(static_cast<int>(edges.size())));
 }
 
 // Pathfinding Operations
@@ -1353,84 +1400,162 @@ void MainWindow::findDijkstraPath() {
         return;
     }
     
-    // Implement our own path finding based on Dijkstra algorithm
-    const auto& adjList = graph.getAdjList();
+    activeRoute.reset();
+    PathResult result = PathEngine::find(graph, fromCity.toStdString(), toCity.toStdString(),
+                                         PathAlgorithm::Dijkstra);
+    if (!result.found()) {
+        logMessage("Error: No path found from " + fromCity + " to " + toCity +
+                   (result.ruledOut ? " (ruled out by the strong components, no search needed)" : ""));
+        return;
+    }
+    showPathResult(PathAlgorithm::Dijkstra, result);
+    
+    // Keep a shortest-path tree from the source so later edits only repair the route;
+    // it is built by the engine on the same CSR snapshot
+    activeRoute = make_unique<ShortestPathTree>(graph, fromCity.toStdString());
+    activeRouteTarget = QString::fromStdString(Graph::standardizeCity(toCity.toStdString()));
+}
+
+void MainWindow::findAStarPath() {
+    QString fromCity = pathFromInput->text().trimmed();
+    QString toCity = pathToInput->text().trimmed();
+    
+    if (fromCity.isEmpty() || toCity.isEmpty()) {
+        logMessage("Error: City names cannot be empty");
+        return;
+    }
     
-    // Standardize city names
-    string standardFrom = Graph::standardizeCity(fromCity.toStdString());
-    string standardTo = Graph::standardizeCity(toCity.toStdString());
+    if (!graph.cityExists(fromCity.toStdString())) {
+        logMessage("Error: City " + fromCity + " does not exist");
+        return;
+    }
     
-    // Initialize data structures
-    unordered_map<string, int> distances;
-    unordered_map<string, string> previous;
-    priority_queue<pair<int, string>, 
-                  vector<pair<int, string>>, 
-                  greater<pair<int, string>>> pq;
+    if (!graph.cityExists(toCity.toStdString())) {
+        logMessage("Error: City " + toCity + " does not exist");
+        return;
+    }
     
-    // Set initial distances
-    for (const auto& [city, _] : adjList) {
-        distances[city] = numeric_limits<int>::max();
+    activeRoute.reset();
+    PathResult result = PathEngine::find(graph, fromCity.toStdString(), toCity.toStdString(),
+                                         PathAlgorithm::AStar);
+    if (!result.found()) {
+        logMessage("Error: No path found from " + fromCity + " to " + toCity +
+                   (result.ruledOut ? " (ruled out by the strong components, no search needed)" : ""));
+        return;
+    }
+    showPathResult(PathAlgorithm::AStar, result);
+}
+
+void MainWindow::showIsochrone() {
+    QString hubCity = pathFromInput->text().trimmed();
+    if (hubCity.isEmpty()) {
+        logMessage("Error: Enter the hub city in the From field");
+        return;
+    }
+    if (!graph.cityExists(hubCity.toStdString())) {
+        logMessage("Error: City " + hubCity + " does not exist");
+        return;
     }
-    distances[standardFrom] = 0;
-    pq.push({0, standardFrom});
     
-    while (!pq.empty()) {
-        string current = pq.top().second;
-        int currentDist = pq.top().first;
-        pq.pop();
-        
-        // If we've found a better path to current, skip
-        if (currentDist > distances[current]) continue;
-        
-        // If we've reached the end city, we're done
-        if (current == standardTo) break;
-        
-        // Check all neighbors
-        if (adjList.find(current) != adjList.end()) {
-            for (const auto& [neighbor, dist] : adjList.at(current)) {
-                int newDist = distances[current] + dist;
-                
-                if (newDist < distances[neighbor]) {
-                    distances[neighbor] = newDist;
-                    previous[neighbor] = current;
-                    pq.push({newDist, neighbor});
-                }
-            }
+    vector<int> budgets;
+    for (const QString& part : budgetInput->text().split(QRegularExpression("[,\\s]+"))) {
+        if (part.isEmpty()) continue;
+        bool ok;
+        int budget = part.toInt(&ok);
+        if (!ok || budget < 0) {
+            logMessage("Error: Budgets must be non-negative numbers");
+            return;
         }
+        budgets.push_back(budget);
+    }
+    budgets = Isochrone::normalizeBudgets(budgets);
+    if (budgets.empty()) {
+        logMessage("Error: Enter at least one budget");
+        return;
+    }
+    
+    activeRoute.reset();
+    vector<ReachableCity> cities = Isochrone::reachable(graph, hubCity.toStdString(), budgets);
+    updateGraphDisplay();
+    
+    // Dim everything, then shade reached cities from green (near) to red (far)
+    QColor unreachedColor = isDarkMode ? QColor(70, 70, 70) : QColor(210, 210, 210);
+    for (auto node : nodeItems) {
+        node->setBrush(QBrush(unreachedColor));
+    }
+    vector<int> bandSizes(budgets.size(), 0);
+    for (const auto& reached : cities) {
+        QString cityStr = QString::fromStdString(graph.cityName(reached.city));
+        bandSizes[reached.band]++;
+        if (!nodeItems.contains(cityStr)) continue;
+        qreal t = budgets.size() > 1 ? reached.band / static_cast<qreal>(budgets.size() - 1) : 0.0;
+        nodeItems[cityStr]->setBrush(QBrush(QColor::fromHsvF((1.0 - t) / 3.0, 0.7, isDarkMode ? 0.8 : 0.95)));
+        nodeItems[cityStr]->setToolTip(cityStr + ": " + QString::number(reached.distance));
     }
     
-    // If we couldn't reach the end city
-    if (distances[standardTo] == numeric_limits<int>::max()) {
-        logMessage("Error: No path found from " + fromCity + " to " + toCity);
+    int total = 0;
+    for (size_t band = 0; band < budgets.size(); ++band) {
+        total += bandSizes[band];
+        logMessage(QString("Within %1 of %2: %3 cities (%4 new)")
+                  .arg(budgets[band]).arg(hubCity).arg(total).arg(bandSizes[band]));
+    }
+}
+
+void MainWindow::showServiceRegions() {
+    vector<string> facilities;
+    for (const QString& part : facilitiesInput->text().split(QRegularExpression("[,\\s]+"))) {
+        if (part.isEmpty()) continue;
+        if (!graph.cityExists(part.toStdString())) {
+            logMessage("Error: City " + part + " does not exist");
+            return;
+        }
+        facilities.push_back(Graph::standardizeCity(part.toStdString()));
+    }
+    if (facilities.empty()) {
+        logMessage("Error: Enter at least one facility city");
         return;
     }
     
-    // Reconstruct path
-    vector<string> path;
-    string current = standardTo;
+    activeRoute.reset();
+    ServiceAssignment assignment = ServiceRegions::assign(graph, facilities);
+    updateGraphDisplay();
     
-    while (current != standardFrom) {
-        path.push_back(current);
-        current = previous.at(current);
+    // One hue per facility, spread by the golden ratio so neighbours differ
+    QColor unservedColor = isDarkMode ? QColor(70, 70, 70) : QColor(210, 210, 210);
+    vector<QColor> colors;
+    for (size_t i = 0; i < facilities.size(); ++i) {
+        colors.push_back(QColor::fromHsvF(fmod(i * 0.618033988749895, 1.0), 0.65, isDarkMode ? 0.8 : 0.95));
     }
-    path.push_back(standardFrom);
     
-    // Reverse path to get from->to order
-    reverse(path.begin(), path.end());
+    vector<int> regionSizes(facilities.size(), 0);
+    for (auto it = nodeItems.begin(); it != nodeItems.end(); ++it) {
+        int city = graph.cityId(it.key().toStdString());
+        int facility = city < 0 ? -1 : assignment.nearest[city];
+        if (facility < 0) {
+            it.value()->setBrush(QBrush(unservedColor));
+            it.value()->setToolTip(it.key() + ": not served");
+            continue;
+        }
+        regionSizes[facility]++;
+        it.value()->setBrush(QBrush(colors[facility]));
+        it.value()->setToolTip(it.key() + ": " + QString::fromStdString(facilities[facility]) +
+                               " (" + QString::number(assignment.distance[city]) + ")");
+    }
     
-    // Convert path to QStringList for highlighting
-    QStringList pathStringList;
-    for (const auto& city : path) {
-        pathStringList << QString::fromStdString(city);
+    // Outline the facilities themselves
+    for (const auto& facility : facilities) {
+        QString cityStr = QString::fromStdString(facility);
+        if (nodeItems.contains(cityStr)) {
+            nodeItems[cityStr]->setPen(QPen(isDarkMode ? Qt::white : Qt::black, 4.0));
+        }
     }
     
-    // Update display with highlighted path
-    updateGraphDisplay(pathStringList.join(","));
-    logMessage("Dijkstra shortest path from " + fromCity + " to " + toCity + 
-               " (distance: " + QString::number(distances[standardTo]) + "): " + pathStringList.join(" -> "));
+    for (size_t i = 0; i < facilities.size(); ++i) {
+        logMessage(QString("%1 serves %2 cities").arg(QString::fromStdString(facilities[i])).arg(regionSizes[i]));
+    }
 }
 
-void MainWindow::findAStarPath() {
+void MainWindow::showMinCut() {
     QString fromCity = pathFromInput->text().trimmed();
     QString toCity = pathToInput->text().trimmed();
     
@@ -1439,94 +1564,142 @@ void MainWindow::findAStarPath() {
         return;
     }
     
-    if (!graph.cityExists(fromCity.toStdString())) {
-        logMessage("Error: City " + fromCity + " does not exist");
+    int source = graph.cityId(fromCity.toStdString());
+    int sink = graph.cityId(toCity.toStdString());
+    if (source < 0 || sink < 0) {
+        logMessage("Error: City " + (source < 0 ? fromCity : toCity) + " does not exist");
         return;
     }
-    
-    if (!graph.cityExists(toCity.toStdString())) {
-        logMessage("Error: City " + toCity + " does not exist");
+    if (source == sink) {
+        logMessage("Error: Source and sink must be different cities");
         return;
     }
     
-    // Using Dijkstra for now as A* requires heuristics 
-    logMessage("A* currently using Dijkstra's algorithm as a fallback...");
-    
-    // Call the Dijkstra method (reusing the same code from above)
-    const auto& adjList = graph.getAdjList();
-    
-    // Standardize city names
-    string standardFrom = Graph::standardizeCity(fromCity.toStdString());
-    string standardTo = Graph::standardizeCity(toCity.toStdString());
-    
-    // Initialize data structures
-    unordered_map<string, int> distances;
-    unordered_map<string, string> previous;
-    priority_queue<pair<int, string>, 
-                  vector<pair<int, string>>, 
-                  greater<pair<int, string>>> pq;
+    activeRoute.reset();
+    FlowResult result = MaxFlow::compute(*graph.compact(), source, sink);
+    updateGraphDisplay();
+    if (nodeItems.isEmpty()) {
+        return;
+    }
     
-    // Set initial distances
-    for (const auto& [city, _] : adjList) {
-        distances[city] = numeric_limits<int>::max();
+    // Tint the two sides of the cut, then draw the cut roads over them
+    QColor sourceColor = isDarkMode ? QColor(70, 130, 180) : QColor(135, 190, 235);
+    QColor sinkColor = isDarkMode ? QColor(120, 120, 120) : QColor(215, 215, 215);
+    for (auto it = nodeItems.begin(); it != nodeItems.end(); ++it) {
+        int city = graph.cityId(it.key().toStdString());
+        if (city < 0) continue;
+        bool onSourceSide = result.sourceSide[city] != 0;
+        it.value()->setBrush(QBrush(onSourceSide ? sourceColor : sinkColor));
+        it.value()->setToolTip(it.key() + (onSourceSide ? ": source side of the cut" : ": sink side of the cut"));
     }
-    distances[standardFrom] = 0;
-    pq.push({0, standardFrom});
     
-    while (!pq.empty()) {
-        string current = pq.top().second;
-        int currentDist = pq.top().first;
-        pq.pop();
-        
-        // If we've found a better path to current, skip
-        if (currentDist > distances[current]) continue;
-        
-        // If we've reached the end city, we're done
-        if (current == standardTo) break;
-        
-        // Check all neighbors
-        if (adjList.find(current) != adjList.end()) {
-            for (const auto& [neighbor, dist] : adjList.at(current)) {
-                int newDist = distances[current] + dist;
-                
-                if (newDist < distances[neighbor]) {
-                    distances[neighbor] = newDist;
-                    previous[neighbor] = current;
-                    pq.push({newDist, neighbor});
-                }
+    const auto& adjList = graph.getAdjList();
+    QColor cutColor(220, 20, 60);
+    QStringList cutLabels;
+    for (const auto& edge : result.cut) {
+        DraggableNode *fromNode = edge.from < nodesById.size() ? nodesById[edge.from] : nullptr;
+        DraggableNode *toNode = edge.to < nodesById.size() ? nodesById[edge.to] : nullptr;
+        if (!fromNode || !toNode) continue;
+        
+        // Curve the same way as the normal drawing when the road runs both ways
+        bool hasBidirectional = false;
+        for (const auto& [neighbor, _] : adjList.at(graph.cityName(edge.to))) {
+            if (neighbor == graph.cityName(edge.from)) {
+                hasBidirectional = true;
+                break;
             }
         }
+        drawCurvedArrow(graphScene, fromNode->pos(), toNode->pos(), QString::number(edge.capacity),
+                        cutColor, 4.0, true, hasBidirectional);
+        cutLabels << QString("%1 -> %2 (%3)")
+                         .arg(QString::fromStdString(graph.cityName(edge.from)),
+                              QString::fromStdString(graph.cityName(edge.to)))
+                         .arg(edge.capacity);
     }
     
-    // If we couldn't reach the end city
-    if (distances[standardTo] == numeric_limits<int>::max()) {
-        logMessage("Error: No path found from " + fromCity + " to " + toCity);
+    QString endpoints = QString::fromStdString(graph.cityName(source)) + " to " +
+                        QString::fromStdString(graph.cityName(sink));
+    if (result.cut.empty()) {
+        logMessage("No flow from " + endpoints + ": the sink cannot be reached");
         return;
     }
-    
-    // Reconstruct path
-    vector<string> path;
-    string current = standardTo;
-    
-    while (current != standardFrom) {
-        path.push_back(current);
-        current = previous.at(current);
+    logMessage(QString("Maximum flow from %1: %2, limited by %3 road(s): %4")
+              .arg(endpoints)
+              .arg(result.value)
+              .arg(static_cast<int>(result.cut.size()))
+              .arg(cutLabels.join(", ")));
+}
+
+void MainWindow::showStrongComponents() {
+    activeRoute.reset();
+    updateGraphDisplay();
+    if (nodeItems.isEmpty()) {
+        return;
     }
-    path.push_back(standardFrom);
     
-    // Reverse path to get from->to order
-    reverse(path.begin(), path.end());
+    auto components = graph.strongComponents();
     
-    // Convert path to QStringList for highlighting
-    QStringList pathStringList;
-    for (const auto& city : path) {
-        pathStringList << QString::fromStdString(city);
+    // One hue per component with more than one city; one-city components stay neutral
+    QColor singletonColor = isDarkMode ? QColor(70, 70, 70) : QColor(210, 210, 210);
+    QMap<int, QColor> colors;
+    int multiCityComponents = 0;
+    for (auto it = nodeItems.begin(); it != nodeItems.end(); ++it) {
+        int city = graph.cityId(it.key().toStdString());
+        if (city < 0) continue;
+        int component = components->componentOf(city);
+        if (components->componentSize(component) == 1) {
+            it.value()->setBrush(QBrush(singletonColor));
+            it.value()->setToolTip(it.key() + ": on no cycle");
+            continue;
+        }
+        if (!colors.contains(component)) {
+            colors[component] = QColor::fromHsvF(fmod(multiCityComponents++ * 0.618033988749895, 1.0),
+                                                 0.65, isDarkMode ? 0.8 : 0.95);
+        }
+        it.value()->setBrush(QBrush(colors[component]));
+        it.value()->setToolTip(QString("%1: component %2 (%3 cities)")
+                              .arg(it.key())
+                              .arg(component)
+                              .arg(components->componentSize(component)));
     }
     
+    int largest = components->largestComponent();
+    logMessage(QString("%1 strongly connected components (%2 with more than one city); the largest has %3 of %4 cities")
+              .arg(components->componentCount())
+              .arg(multiCityComponents)
+              .arg(largest < 0 ? 0 : components->componentSize(largest))
+              .arg(nodeItems.size()));
+}
+
+void MainWindow::showPathResult(PathAlgorithm algorithm, const PathResult& result) {
     // Update display with highlighted path
-    updateGraphDisplay(pathStringList.join(","));
-    logMessage("A* shortest path from " + fromCity + " to " + toCity + 
-               " (distance: " + QString::number(distances[standardTo]) + "): " + pathStringList.join(" -> "));
+    updateGraphDisplay(result.nodes);
+    QString stats = result.fromCache
+        ? QString("from cache")
+        : QString("%1 cities settled in %2 ms").arg(result.settled).arg(result.milliseconds, 0, 'f', 2);
+    logMessage(QString::fromStdString(PathEngine::algorithmName(algorithm)) + " shortest path from " +
+               QString::fromStdString(graph.cityName(result.nodes.front())) + " to " +
+               QString::fromStdString(graph.cityName(result.nodes.back())) +
+               " (distance: " + QString::number(result.distance) + ", " + stats + "): " +
+               pathLabel(result.nodes));
+}
+
+const CentralityScores& MainWindow::currentCentrality() {
+    if (!centrality || centralityVersion != graph.version()) {
+        auto compact = graph.compact();
+        int samples = compact->liveCount > Centrality::EXACT_LIMIT ? Centrality::DEFAULT_SAMPLES : 0;
+        centrality = make_shared<const CentralityScores>(
+            Centrality::compute(*compact, true, ThreadPool::shared(), samples));
+        centralityVersion = graph.version();
+        logMessage(QString("Betweenness computed from %1 of %2 cities")
+                  .arg(centrality->sources)
+                  .arg(compact->liveCount));
+    }
+    return *centrality;
+}
+
+QString MainWindow::pathLabel(const vector<int> &path) const {
+    return QString::fromStdString(PathEngine::formatPath(graph, path));
 }
 
 // Graph Visualization Methods
@@ -1651,6 +1824,7 @@ bool MainWindow::renderDotToSvg(const QString &dotFilePath, const QString &svgFi
 
 void MainWindow::updateGraphDisplay() {
     logMessage("DEBUG: Updating graph display...");
+    stopTraversal();
     
     // Clear the scene, but keep track of node positions
     QMap<QString, QPointF> nodePositions;
@@ -1664,6 +1838,7 @@ void MainWindow::updateGraphDisplay() {
     // Now clear the scene
     graphScene->clear();
     nodeItems.clear();
+    nodesById.clear();
     
     // Get graph data
     const auto& adjList = graph.getAdjList();
@@ -1700,56 +1875,68 @@ void MainWindow::updateGraphDisplay() {
               QString::number(adjList.size()) + " nodes.");
 }
 
-void MainWindow::updateGraphDisplay(const QString &highlightPath) {
+void MainWindow::updateGraphDisplay(const vector<int> &highlightPath) {
     // First update the standard display
     updateGraphDisplay();
     
-    // If no highlight path, we're done
-    if (highlightPath.isEmpty()) {
+    // Need at least two cities for a path
+    if (highlightPath.size() <= 1) {
         return;
     }
     
-    logMessage("DEBUG: Highlighting path: " + highlightPath);
-    
-    // Get the path cities
-    QStringList pathCities = highlightPath.split(",");
-    if (pathCities.size() <= 1) {
-        return;  // Need at least two cities for a path
-    }
-    
-    // Find all node items - we now use our nodeItems map
-    QMap<QString, QPointF> nodePositions;
-    
-    for (auto it = nodeItems.begin(); it != nodeItems.end(); ++it) {
-        nodePositions[it.key()] = it.value()->pos();
-    }
+    auto nodeFor = [this](int city) -> DraggableNode* {
+        return city >= 0 && city < nodesById.size() ? nodesById[city] : nullptr;
+    };
     
     // Highlight the path edges
-    for (int i = 0; i < pathCities.size() - 1; i++) {
-        QString fromCity = pathCities[i];
-        QString toCity = pathCities[i+1];
+    for (size_t i = 0; i + 1 < highlightPath.size(); i++) {
+        DraggableNode *fromNode = nodeFor(highlightPath[i]);
+        DraggableNode *toNode = nodeFor(highlightPath[i + 1]);
         
-        if (nodePositions.contains(fromCity) && nodePositions.contains(toCity)) {
-            QPointF fromPos = nodePositions[fromCity];
-            QPointF toPos = nodePositions[toCity];
-            
+        if (fromNode && toNode) {
             // Draw highlighted arrow
-            drawCurvedArrow(graphScene, fromPos, toPos, "", QColor(255, 102, 0), 3.0, true, false);
+            drawCurvedArrow(graphScene, fromNode->pos(), toNode->pos(), "", QColor(255, 102, 0), 3.0, true, false);
             
-            // Highlight the nodes
-            if (nodeItems.contains(fromCity)) {
-                // Change the node color to orange
-                nodeItems[fromCity]->setBrush(QBrush(QColor(255, 102, 0)));
-            }
+            // Change the node color to orange
+            fromNode->setBrush(QBrush(QColor(255, 102, 0)));
         }
     }
     
     // Always highlight the last node in the path
-    if (!pathCities.isEmpty() && nodeItems.contains(pathCities.last())) {
-        nodeItems[pathCities.last()]->setBrush(QBrush(QColor(255, 102, 0)));
+    if (DraggableNode *lastNode = nodeFor(highlightPath.back())) {
+        lastNode->setBrush(QBrush(QColor(255, 102, 0)));
     }
 }
 
+void MainWindow::refreshDisplay() {
+    if (!activeRoute) {
+        updateGraphDisplay();
+        return;
+    }
+    
+    // The tree has already repaired itself; just read the route back
+    if (!activeRoute->isValid() || !graph.cityExists(activeRouteTarget.toStdString())) {
+        activeRoute.reset();
+        logMessage("Highlighted route cleared: one of its end cities was removed");
+        updateGraphDisplay();
+        return;
+    }
+    
+    vector<int> path = activeRoute->pathTo(activeRouteTarget.toStdString());
+    if (path.empty()) {
+        logMessage("Highlighted route: " + activeRouteTarget + " is no longer reachable from " +
+                   QString::fromStdString(activeRoute->source()));
+        updateGraphDisplay();
+        return;
+    }
+    
+    updateGraphDisplay(path);
+    logMessage(QString("Route updated (%1 cities repaired), distance %2: %3")
+              .arg(activeRoute->lastRepairSize())
+              .arg(activeRoute->distanceTo(activeRouteTarget.toStdString()))
+              .arg(pathLabel(path)));
+}
+
 void MainWindow::calculateForceDirectedLayout(const unordered_map<string, vector<pair<string, int>>>& adjList, 
                                            QMap<QString, QPointF>& nodePositions) {
     // Initialize node positions in a circle
@@ -2205,115 +2392,46 @@ void MainWindow::resolveCollisions(QMap<QString, QPointF>& nodePositions, qreal
 void MainWindow::placeWithHierarchicalLayout(const unordered_map<string, vector<pair<string, int>>>& adjList,
                                           QMap<QString, QPointF>& nodePositions,
                                           const QMap<QString, int>& nodeDegrees) {
-    // Analyze the graph to identify layers (levels in the hierarchy)
-    QMap<QString, int> nodeLayer;     // Maps node name to its layer
-    QMap<int, QList<QString>> layerNodes; // Maps layer number to list of nodes in that layer
-    
-    // First, identify source nodes (nodes with no incoming edges)
-    QSet<QString> allNodes;
-    QSet<QString> hasIncomingEdges;
-    
-    // Collect all nodes and nodes with incoming edges
+    // Number the cities once so the layering runs over plain indices
+    unordered_map<string, int> index;
+    vector<string> names;
+    auto indexOf = [&](const string& city) {
+        auto [it, inserted] = index.emplace(city, static_cast<int>(names.size()));
+        if (inserted) {
+            names.push_back(city);
+        }
+        return it->second;
+    };
+    vector<pair<int, int>> edges;
     for (const auto& [city, neighbors] : adjList) {
-        QString fromCity = QString::fromStdString(city);
-        allNodes.insert(fromCity);
-        
+        int from = indexOf(city);
         for (const auto& [neighbor, _] : neighbors) {
-            QString toCity = QString::fromStdString(neighbor);
-            hasIncomingEdges.insert(toCity);
-            allNodes.insert(toCity);
+            edges.emplace_back(from, indexOf(neighbor));
         }
     }
-    
-    // Source nodes are those without incoming edges
-    QList<QString> sourceNodes;
-    for (const QString& node : allNodes) {
-        if (!hasIncomingEdges.contains(node)) {
-            sourceNodes.append(node);
-        }
-    }
-    
-    // If no source nodes found (cyclic graph), use nodes with fewest incoming edges
-    if (sourceNodes.isEmpty()) {
-        QMap<QString, int> incomingCount;
-        
-        // Count incoming edges for each node
-        for (const auto& [city, neighbors] : adjList) {
-            QString fromCity = QString::fromStdString(city);
-            
-            for (const auto& [neighbor, _] : neighbors) {
-                QString toCity = QString::fromStdString(neighbor);
-                incomingCount[toCity]++;
-            }
-        }
-        
-        // Find minimum incoming edge count
-        int minIncoming = INT_MAX;
-        for (auto it = incomingCount.begin(); it != incomingCount.end(); ++it) {
-            minIncoming = qMin(minIncoming, it.value());
-        }
-        
-        // Use nodes with minimum incoming edges as source nodes
-        for (auto it = incomingCount.begin(); it != incomingCount.end(); ++it) {
-            if (it.value() == minIncoming) {
-                sourceNodes.append(it.key());
-            }
-        }
-    }
-    
-    // Breadth-first traversal to assign layers
-    QQueue<QString> queue;
-    QSet<QString> visited;
-    
-    // Start with source nodes in layer 0
-    for (const QString& node : sourceNodes) {
-        nodeLayer[node] = 0;
-        layerNodes[0].append(node);
-        queue.enqueue(node);
-        visited.insert(node);
+    vector<vector<int>> successors(names.size());
+    vector<vector<int>> predecessors(names.size());
+    for (const auto& [from, to] : edges) {
+        successors[from].push_back(to);
+        predecessors[to].push_back(from);
     }
     
-    // Process remaining nodes in breadth-first order
-    while (!queue.isEmpty()) {
-        QString current = queue.dequeue();
-        int currentLayer = nodeLayer[current];
-        
-        // Get neighbors of current node
-        for (const auto& [city, neighbors] : adjList) {
-            if (QString::fromStdString(city) == current) {
-                for (const auto& [neighbor, _] : neighbors) {
-                    QString next = QString::fromStdString(neighbor);
-                    
-                    // If not visited, assign to next layer
-                    if (!visited.contains(next)) {
-                        int nextLayer = currentLayer + 1;
-                        nodeLayer[next] = nextLayer;
-                        layerNodes[nextLayer].append(next);
-                        queue.enqueue(next);
-                        visited.insert(next);
-                    }
-                    // If already visited but in same or earlier layer, move to a later layer
-                    else if (nodeLayer[next] <= currentLayer) {
-                        int nextLayer = currentLayer + 1;
-                        // Remove from old layer
-                        layerNodes[nodeLayer[next]].removeAll(next);
-                        // Add to new layer
-                        nodeLayer[next] = nextLayer;
-                        layerNodes[nextLayer].append(next);
-                    }
-                }
-            }
-        }
+    // Longest-path layers from the core topological sort; cycles are broken
+    // by letting a few feedback edges point upwards
+    Layering layering = TopologicalSort::layers(successors);
+    if (!layering.acyclic()) {
+        logMessage(QString("Hierarchical layout: %1 edge(s) point upwards to break cycles")
+                  .arg(static_cast<int>(layering.feedbackArcs.size())));
     }
     
-    // Handle any unvisited nodes (disconnected from source)
-    for (const QString& node : allNodes) {
-        if (!visited.contains(node)) {
-            // Assign unconnected nodes to a new layer below all others
-            int newLayer = layerNodes.isEmpty() ? 0 : layerNodes.keys().last() + 1;
-            nodeLayer[node] = newLayer;
-            layerNodes[newLayer].append(node);
-        }
+    QMap<QString, int> nodeLayer;     // Maps node name to its layer
+    QMap<int, QList<QString>> layerNodes; // Maps layer number to list of nodes in that layer
+    QSet<QString> allNodes;
+    for (int node : layering.order) {
+        QString name = QString::fromStdString(names[node]);
+        allNodes.insert(name);
+        nodeLayer[name] = layering.layer[node];
+        layerNodes[layering.layer[node]].append(name);
     }
     
     // Calculate positions based on layers
@@ -2346,19 +2464,10 @@ void MainWindow::placeWithHierarchicalLayout(const unordered_map<string, vector<
                 averageConnectedX[node] = 0.0;
                 int connectedCount = 0;
                 
-                // Check nodes in previous layer for connections
-                for (const QString& prevNode : layerNodes[layer-1]) {
-                    // Check if prevNode has an edge to node
-                    for (const auto& [city, neighbors] : adjList) {
-                        if (QString::fromStdString(city) == prevNode) {
-                            for (const auto& [neighbor, _] : neighbors) {
-                                if (QString::fromStdString(neighbor) == node) {
-                                    averageConnectedX[node] += nodePositions[prevNode].x();
-                                    connectedCount++;
-                                break;
-                            }
-                        }
-                    }
+                for (int previous : predecessors[index.at(node.toStdString())]) {
+                    if (layering.layer[previous] == layer - 1) {
+                        averageConnectedX[node] += nodePositions[QString::fromStdString(names[previous])].x();
+                        connectedCount++;
                     }
                 }
                 
@@ -2702,6 +2811,7 @@ void MainWindow::drawGraphNodes(const unordered_map<string, vector<pair<string,
     // Clear existing node map but keep references for deletion
     QMap<QString, DraggableNode*> oldNodeItems = nodeItems;
     nodeItems.clear();
+    nodesById.fill(nullptr);
     
     // Count incoming and outgoing connections for each node
     QMap<QString, int> incomingEdges;
@@ -2747,6 +2857,18 @@ void MainWindow::drawGraphNodes(const unordered_map<string, vector<pair<string,
         maxNodeWeight = qMax(maxNodeWeight, totalWeight[cityStr]);
     }
     
+    // Betweenness replaces the connection count as the importance measure when asked for
+    const CentralityScores *scores = sizeByCentralityCheck->isChecked() ? &currentCentrality() : nullptr;
+    double maxBetweenness = 0.0;
+    if (scores) {
+        for (const auto& [city, _] : adjList) {
+            int cityId = graph.cityId(city);
+            if (cityId >= 0) {
+                maxBetweenness = qMax(maxBetweenness, scores->betweenness[cityId]);
+            }
+        }
+    }
+    
     // Theme-aware color palette
     QColor textColor = isDarkMode ? Qt::white : Qt::black;
     QColor shadowColor = isDarkMode ? QColor(0, 0, 0, 200) : QColor(100, 100, 100, 150);
@@ -2763,6 +2885,11 @@ void MainWindow::drawGraphNodes(const unordered_map<string, vector<pair<string,
         // Size between 15 and 40 radius
         int connections = incomingEdges[cityStr] + outgoingEdges[cityStr];
         qreal importanceFactor = 0.5 + 0.5 * sqrt(connections / qMax(1.0, static_cast<qreal>(maxConnections)));
+        if (scores) {
+            int cityId = graph.cityId(city);
+            qreal betweenness = cityId >= 0 ? scores->betweenness[cityId] : 0.0;
+            importanceFactor = maxBetweenness > 0 ? sqrt(betweenness / maxBetweenness) : 0.0;
+        }
         qreal nodeSize = 20.0 + importanceFactor * 25.0; // Radius between 20 and 45
         
         // Choose node color based on incoming/outgoing ratio
@@ -2809,6 +2936,13 @@ void MainWindow::drawGraphNodes(const unordered_map<string, vector<pair<string,
         
         // Store in map for later access
         nodeItems[cityStr] = node;
+        int cityId = graph.cityId(city);
+        if (cityId >= 0) {
+            if (cityId >= nodesById.size()) {
+                nodesById.resize(cityId + 1);
+            }
+            nodesById[cityId] = node;
+        }
         
         // Add label
         QGraphicsTextItem *label = graphScene->addText(cityStr);
@@ -4,13 +4,25 @@
 #include "../include/Dijkstra.hpp"
 #include "../include/Utilities.hpp"
 #include "../include/FindPath.hpp"
+#include "../include/BatchRunner.hpp"
+#include "../include/Isochrone.hpp"
+#include "../include/ServiceRegions.hpp"
+#include "../include/Centrality.hpp"
+#include "../include/Eccentricity.hpp"
+#include "../include/MaxFlow.hpp"
+#include "../include/HyperAnf.hpp"
 #include <iostream>
 #include <string>
 #include <limits>
 
 using namespace std;
 
-int main() {
+int main(int argc, char* argv[]) {
+    // Any command-line arguments select the non-interactive batch mode
+    if (argc > 1) {
+        return BatchRunner::run(argc, argv);
+    }
+
     Graph g;
     int choice;
     string filename; 
@@ -89,6 +101,40 @@ int main() {
             g.sortConnections(true); // Sort by distance
             continue;
         }
+        else if (choice == 13) {
+            string from = utilities.getCityInput("From: ", g, true);
+            if (utilities.goBack(from)) continue;
+            string to = utilities.getCityInput("To: ", g, true);
+            if (utilities.goBack(to)) continue;
+            int dist = utilities.getIntInput("New distance: ");
+            if (dist == -1) continue;
+            g.updateEdge(from, to, dist);
+            continue;
+        }
+        else if (choice == 14) {
+            Isochrone::findReachable(g);
+            continue;
+        }
+        else if (choice == 15) {
+            ServiceRegions::findNearest(g);
+            continue;
+        }
+        else if (choice == 16) {
+            Centrality::showRanking(g);
+            continue;
+        }
+        else if (choice == 17) {
+            Eccentricity::showDiameter(g);
+            continue;
+        }
+        else if (choice == 18) {
+            MaxFlow::showCapacity(g);
+            continue;
+        }
+        else if (choice == 19) {
+            HyperAnf::showStatistics(g);
+            continue;
+        }
         else {
             cout << "Feature not implemented yet.\n";
         }